@@ -0,0 +1,42 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FRAME ARENA IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "arena.h"
+#include "memmap.h"
+
+static uint8_t arena[FRAME_ARENA_BYTES] __attribute__((aligned(8)));
+static size_t  used = 0, peak = 0;
+static bool    reported = false, mapped = false;
+
+void frameReset() {
+  if (!mapped) memRegister("frameArena", "arena", arena, sizeof(arena), MEM_SRAM, true);
+  mapped = true;
+  used = 0;
+}
+
+void* frameAlloc(size_t bytes) {
+  bytes = (bytes + 7) & ~(size_t)7;
+  if (bytes > FRAME_ARENA_BYTES - used) {
+    if (!reported) Serial.println("ERROR: Frame arena full, raise FRAME_ARENA_BYTES");
+    reported = true;
+    return nullptr;
+  }
+  void* p = arena + used;
+  used += bytes;
+  if (used > peak) peak = used;
+  return p;
+}
+
+size_t frameMark() {
+  return used;
+}
+
+void frameRelease(size_t mark) {
+  if (mark < used) used = mark;
+}
+
+size_t frameArenaUsed() { return used; }
+size_t frameArenaPeak() { return peak; }
@@ -0,0 +1,41 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FRAME ARENA
+  Bump allocator for data that only lives for one frame (projected
+  vertices, sort keys, visible-object lists, display list spans).
+  loop() resets it at the start of every frame, so nothing is ever
+  freed one by one; a renderer that only needs scratch while it runs
+  takes a frameMark() and hands it back with frameRelease(). The
+  buffer is a static array, so it sits in internal SRAM on the ESP32
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <Arduino.h>
+
+#define FRAME_ARENA_BYTES  32768      // Per-frame scratch, internal SRAM
+
+// Start a new frame: everything allocated so far is dropped. Any display
+// list commands (displist.h) must have been flushed
+void frameReset();
+
+// bytes of scratch, 8-byte aligned, or nullptr if the arena is full
+// (reported once on Serial)
+void* frameAlloc(size_t bytes);
+
+template <typename T>
+inline T* frameAlloc(int count) {
+  return (T*)frameAlloc((size_t)max(count, 0) * sizeof(T));
+}
+
+// Release everything allocated after the mark (last in, first out)
+size_t frameMark();
+void   frameRelease(size_t mark);
+
+// Bytes in use now, and the most ever in use in one frame
+size_t frameArenaUsed();
+size_t frameArenaPeak();
+
+#endif // ARENA_H
@@ -0,0 +1,171 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  RASTERIZATION PRIMITIVE MICRO-BENCHMARK IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "bench_prims.h"
+#include "rendering.h"
+#include "config.h"
+
+#define BENCH_MIN_US   20000      // Grow the call count until a case takes this long
+#define BENCH_X        8          // Top-left of the drawing area
+#define BENCH_Y        8
+
+static const int benchSizes[] = { 4, 16, 64, 160 };
+
+static inline uint16_t benchColor(uint32_t i) {
+  return (i & 1) ? TFT_RED : TFT_BLUE;
+}
+
+static inline int clampW(int w) { return min(w, SCR_W - BENCH_X); }
+static inline int clampH(int h) { return min(h, SCR_H - BENCH_Y); }
+
+// ═══════════════════════════════════════════════════════════════
+//  CASES
+//  draw(size, i) issues one call; pixels(size) is the area it
+//  covers (analytic, after clipping to the drawing area)
+// ═══════════════════════════════════════════════════════════════
+
+static void rectSquare(int s, uint32_t i) { spr.fillRect(BENCH_X, BENCH_Y, clampW(s), clampH(s), benchColor(i)); }
+static float rectSquarePx(int s)          { return (float)clampW(s) * clampH(s); }
+
+static void rectWide(int s, uint32_t i)   { spr.fillRect(BENCH_X, BENCH_Y, clampW(s * 4), max(1, s / 4), benchColor(i)); }
+static float rectWidePx(int s)            { return (float)clampW(s * 4) * max(1, s / 4); }
+
+static void rectTall(int s, uint32_t i)   { spr.fillRect(BENCH_X, BENCH_Y, max(1, s / 4), clampH(s * 4), benchColor(i)); }
+static float rectTallPx(int s)            { return (float)max(1, s / 4) * clampH(s * 4); }
+
+static void hline(int s, uint32_t i)      { spr.drawFastHLine(BENCH_X, BENCH_Y, clampW(s), benchColor(i)); }
+static float hlinePx(int s)               { return (float)clampW(s); }
+
+static void lineH(int s, uint32_t i)      { spr.drawLine(BENCH_X, BENCH_Y, BENCH_X + clampW(s) - 1, BENCH_Y, benchColor(i)); }
+static void lineV(int s, uint32_t i)      { spr.drawLine(BENCH_X, BENCH_Y, BENCH_X, BENCH_Y + clampH(s) - 1, benchColor(i)); }
+static void lineDiag(int s, uint32_t i)   { int d = clampH(s) - 1; spr.drawLine(BENCH_X, BENCH_Y, BENCH_X + d, BENCH_Y + d, benchColor(i)); }
+static void lineShallow(int s, uint32_t i){ spr.drawLine(BENCH_X, BENCH_Y, BENCH_X + clampW(s) - 1, BENCH_Y + s / 4, benchColor(i)); }
+static float lineHPx(int s)               { return (float)clampW(s); }
+static float lineVPx(int s)               { return (float)clampH(s); }
+
+// Triangles: flat bottom, general (no horizontal edge), half off-screen
+static void triFlat(int s, uint32_t i) {
+  int w = clampW(s), h = clampH(s);
+  spr.fillTriangle(BENCH_X + w / 2, BENCH_Y, BENCH_X, BENCH_Y + h - 1, BENCH_X + w - 1, BENCH_Y + h - 1, benchColor(i));
+}
+static void triGeneral(int s, uint32_t i) {
+  int w = clampW(s), h = clampH(s);
+  spr.fillTriangle(BENCH_X, BENCH_Y, BENCH_X + w - 1, BENCH_Y + h / 3, BENCH_X + w / 3, BENCH_Y + h - 1, benchColor(i));
+}
+static void triClipped(int s, uint32_t i) {
+  int w = clampW(s), h = clampH(s);
+  spr.fillTriangle(-w / 2, BENCH_Y, w / 2, BENCH_Y + h - 1, -w / 2, BENCH_Y + h - 1, benchColor(i));
+}
+static float triPx(int s)        { return clampW(s) * clampH(s) * 0.5f; }
+static float triClippedPx(int s) { return clampW(s) * clampH(s) * 0.125f; }
+
+// Quads as drawn by the road (horizontal parallel edges), by building
+// walls (vertical parallel edges) and a rotated square
+static void quadRoad(int s, uint32_t i) {
+  int w = clampW(s), h = clampH(s);
+  drawQuad(BENCH_X, BENCH_Y + h - 1, BENCH_X + w - 1, BENCH_Y + h - 1,
+           BENCH_X + w * 3 / 4, BENCH_Y, BENCH_X + w / 4, BENCH_Y, benchColor(i));
+}
+static void quadRoadClip(int s, uint32_t i) {
+  int w = clampW(s * 2), h = clampH(s);
+  drawQuad(-w / 2, BENCH_Y + h - 1, w / 2, BENCH_Y + h - 1,
+           w / 4, BENCH_Y, -w / 4, BENCH_Y, benchColor(i));
+}
+static void quadWall(int s, uint32_t i) {
+  int w = clampW(s), h = clampH(s);
+  drawQuad(BENCH_X, BENCH_Y, BENCH_X, BENCH_Y + h - 1,
+           BENCH_X + w - 1, BENCH_Y + h * 3 / 4, BENCH_X + w - 1, BENCH_Y + h / 4, benchColor(i));
+}
+static void quadDiamond(int s, uint32_t i) {
+  int h = clampH(s), r = h / 2;
+  int cx = BENCH_X + r, cy = BENCH_Y + r;
+  drawQuad(cx, cy - r, cx + r, cy, cx, cy + r, cx - r, cy, benchColor(i));
+}
+static float quadTrapPx(int s)    { return clampW(s) * clampH(s) * 0.75f; }
+static float quadClipPx(int s)    { return clampW(s * 2) * clampH(s) * 0.375f; }
+static float quadDiamondPx(int s) { int h = clampH(s); return h * h * 0.5f; }
+
+static void circle(int s, uint32_t i) {
+  int r = clampH(s) / 2;
+  spr.fillCircle(BENCH_X + r, BENCH_Y + r, r, benchColor(i));
+}
+static float circlePx(int s) { float r = clampH(s) / 2; return (float)PI * r * r; }
+
+// drawTexturedTri skips spans wider than 160 px, so stay below that
+static void texTri(int s, float light) {
+  float w = min(s, 150), h = clampH(s);
+  drawTexturedTri(BENCH_X, BENCH_Y, 0, 1,
+                  BENCH_X + w, BENCH_Y + h, 1, 0,
+                  BENCH_X, BENCH_Y + h, 0, 0, light);
+}
+static void texTriLit(int s, uint32_t)  { texTri(s, 1.0f); }
+static void texTriDark(int s, uint32_t) { texTri(s, 0.6f); }
+static float texTriPx(int s) { return min(s, 150) * clampH(s) * 0.5f; }
+
+struct BenchCase {
+  const char* prim;
+  const char* shape;
+  void  (*draw)(int size, uint32_t i);
+  float (*pixels)(int size);
+};
+
+static const BenchCase benchCases[] = {
+  { "fillRect",     "square",   rectSquare,   rectSquarePx },
+  { "fillRect",     "wide",     rectWide,     rectWidePx },
+  { "fillRect",     "tall",     rectTall,     rectTallPx },
+  { "drawFastHLine","-",        hline,        hlinePx },
+  { "drawLine",     "horiz",    lineH,        lineHPx },
+  { "drawLine",     "vert",     lineV,        lineVPx },
+  { "drawLine",     "diag",     lineDiag,     lineVPx },
+  { "drawLine",     "shallow",  lineShallow,  lineHPx },
+  { "fillTriangle", "flat",     triFlat,      triPx },
+  { "fillTriangle", "general",  triGeneral,   triPx },
+  { "fillTriangle", "clipped",  triClipped,   triClippedPx },
+  { "drawQuad",     "road",     quadRoad,     quadTrapPx },
+  { "drawQuad",     "road-clip",quadRoadClip, quadClipPx },
+  { "drawQuad",     "wall",     quadWall,     quadTrapPx },
+  { "drawQuad",     "diamond",  quadDiamond,  quadDiamondPx },
+  { "fillCircle",   "-",        circle,       circlePx },
+  { "drawTexTri",   "lit",      texTriLit,    texTriPx },
+  { "drawTexTri",   "shaded",   texTriDark,   texTriPx },
+};
+
+// ═══════════════════════════════════════════════════════════════
+//  RUNNER
+// ═══════════════════════════════════════════════════════════════
+
+void runPrimBench(const char* filter) {
+  char line[96];
+  snprintf(line, sizeof(line), "Primitive benchmark on %dx%d sprite", spr.width(), spr.height());
+  Serial.println(line);
+  snprintf(line, sizeof(line), "%-13s %-9s %5s %8s %9s %11s %8s",
+           "primitive", "shape", "size", "pixels", "calls", "ns/call", "ns/px");
+  Serial.println(line);
+
+  for (const BenchCase& c : benchCases) {
+    if (filter && !strstr(c.prim, filter)) continue;
+
+    for (int size : benchSizes) {
+      // Double the call count until the case runs long enough to time
+      uint32_t calls = 1;
+      unsigned long us;
+      for (;;) {
+        unsigned long t0 = micros();
+        for (uint32_t i = 0; i < calls; i++) c.draw(size, i);
+        us = micros() - t0;
+        if (us >= BENCH_MIN_US || calls >= (1u << 24)) break;
+        calls *= 2;
+      }
+
+      float nsCall = us * 1000.0f / calls;
+      float px = c.pixels(size);
+      snprintf(line, sizeof(line), "%-13s %-9s %5d %8.0f %9lu %11.1f %8.2f",
+               c.prim, c.shape, size, px, (unsigned long)calls, nsCall,
+               px > 0 ? nsCall / px : 0.0f);
+      Serial.println(line);
+    }
+  }
+}
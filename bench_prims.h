@@ -0,0 +1,21 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  RASTERIZATION PRIMITIVE MICRO-BENCHMARK
+  Times the primitives the frame is built from (fillRect, drawLine,
+  fillTriangle, drawQuad, fillCircle, drawTexturedTri) over a sweep
+  of sizes and orientations on spr, and prints ns/call and ns/pixel
+  over Serial. Same code on the device (PRIM_BENCH = 1) and on the
+  host (emulator/prim_bench.cpp)
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef BENCH_PRIMS_H
+#define BENCH_PRIMS_H
+
+#include <Arduino.h>
+
+// Run every case whose primitive name contains filter (nullptr = all).
+// spr must already be created.
+void runPrimBench(const char* filter = nullptr);
+
+#endif // BENCH_PRIMS_H
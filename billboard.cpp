@@ -0,0 +1,138 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  SCENERY BILLBOARDS IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "billboard.h"
+#include "rendering.h"
+#include "colors.h"
+#include "memmap.h"
+
+#define BB_CANVAS     64          // Scratch sprite side; mip 0 must fit in it
+#define BB_ATLAS_PX   10240       // Atlas capacity in pixels (20 KB)
+
+// One pre-rasterized image, cropped to its opaque pixels
+struct BBImage {
+  uint16_t offset;          // First pixel in bbAtlas
+  uint8_t  w, h;            // 0 = not built
+  uint8_t  ax, ay;          // Anchor (sprite's ground point) from the top-left
+};
+
+static uint16_t bbAtlas[BB_ATLAS_PX];
+static BBImage  bbImages[2][BB_TYPES][BB_MIPS];   // [night][type][mip]
+
+static inline float mipScale(int mip) { return BB_SCALE0 / (float)(1 << mip); }
+
+// ═══════════════════════════════════════════════════════════════
+//  SHAPES
+//  The original primitive drawings, standing on (sx, bottomY)
+// ═══════════════════════════════════════════════════════════════
+
+static void drawShape(TFT_eSprite& s, int type, int sx, int bottomY, float scale, bool night) {
+  switch (type) {
+    case 0: { // Pine
+      int h = (int)(scale * 28000);
+      int w = (int)(scale * 10000);
+      if (h < 3 || w < 2) return;
+      int trunkH = h / 4, trunkW = max(2, w / 5);
+      uint16_t gc = night ? rgb(0, 50, 10) : rgb(0, 130, 25);
+      s.fillRect(sx - trunkW / 2, bottomY - trunkH, trunkW, trunkH, rgb(80, 50, 20));
+      s.fillTriangle(sx, bottomY - h, sx - w / 2, bottomY - trunkH, sx + w / 2, bottomY - trunkH, gc);
+      break;
+    }
+    case 1: { // Rounded tree
+      int h = (int)(scale * 26000);
+      int w = (int)(scale * 12000);
+      if (h < 3 || w < 2) return;
+      int trunkH = h * 2 / 3, trunkW = max(2, w / 8);
+      int leafR  = max(2, w / 2);
+      uint16_t lc = night ? rgb(0, 55, 12) : rgb(0, 140, 30);
+      s.fillRect(sx - trunkW / 2, bottomY - trunkH, trunkW, trunkH, rgb(120, 80, 30));
+      s.fillCircle(sx, bottomY - trunkH - leafR / 2, leafR, lc);
+      break;
+    }
+    case 2: { // Bush
+      int r = max(2, (int)(scale * 6000));
+      uint16_t bc = night ? rgb(0, 48, 10) : rgb(20, 130, 20);
+      s.fillCircle(sx, bottomY - r, r, bc);
+      break;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  ATLAS
+// ═══════════════════════════════════════════════════════════════
+
+// Crop the opaque pixels of the canvas into the atlas at *used
+static bool storeImage(TFT_eSprite& canvas, BBImage& img, int* used) {
+  const uint16_t key = (uint16_t)((BB_KEY >> 8) | (BB_KEY << 8));
+  const uint16_t* px = (const uint16_t*)canvas.getPointer();
+
+  int x0 = BB_CANVAS, y0 = BB_CANVAS, x1 = -1, y1 = -1;
+  for (int y = 0; y < BB_CANVAS; y++)
+    for (int x = 0; x < BB_CANVAS; x++)
+      if (px[y * BB_CANVAS + x] != key) {
+        x0 = min(x0, x); x1 = max(x1, x);
+        y0 = min(y0, y); y1 = max(y1, y);
+      }
+  img.w = 0;
+  if (x1 < 0) return true;
+
+  int w = x1 - x0 + 1, h = y1 - y0 + 1;
+  if (*used + w * h > BB_ATLAS_PX) return false;
+
+  uint16_t* dst = bbAtlas + *used;
+  for (int y = 0; y < h; y++)
+    memcpy(dst + y * w, px + (y0 + y) * BB_CANVAS + x0, w * sizeof(uint16_t));
+  img = { (uint16_t)*used, (uint8_t)w, (uint8_t)h,
+          (uint8_t)(BB_CANVAS / 2 - x0), (uint8_t)(BB_CANVAS - y0) };
+  *used += w * h;
+  return true;
+}
+
+void initBillboards() {
+  TFT_eSprite canvas = TFT_eSprite(&tft);
+  canvas.setColorDepth(16);
+  if (canvas.createSprite(BB_CANVAS, BB_CANVAS) == nullptr) {
+    Serial.println("ERROR: Failed to create billboard canvas");
+    return;
+  }
+
+  int used = 0;
+  for (int night = 0; night < 2; night++)
+    for (int type = 0; type < BB_TYPES; type++)
+      for (int mip = 0; mip < BB_MIPS; mip++) {
+        canvas.fillSprite(BB_KEY);
+        drawShape(canvas, type, BB_CANVAS / 2, BB_CANVAS, mipScale(mip), night);
+        if (!storeImage(canvas, bbImages[night][type][mip], &used)) {
+          Serial.println("ERROR: Billboard atlas full");
+          canvas.deleteSprite();
+          return;
+        }
+      }
+  canvas.deleteSprite();
+  memRegister("bbAtlas", "billboard", bbAtlas, sizeof(bbAtlas), MEM_SRAM, true);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  DRAWING
+// ═══════════════════════════════════════════════════════════════
+
+void drawBillboard(int type, int sx, int bottomY, float scale, int clipY, bool night) {
+  // Smallest mip still at least as large as the target (mip 0 is
+  // stretched for the nearest segments)
+  int mip = 0;
+  while (mip + 1 < BB_MIPS && mipScale(mip + 1) >= scale) mip++;
+  const BBImage& img = bbImages[night][type][mip];
+  if (img.w == 0) return;
+
+  float k = scale / mipScale(mip);
+  int h = (int)(img.h * k);
+  int w = max(1, (int)(img.w * k));
+  if (h < 3) return;
+
+  gfxBlitKeyed(bbAtlas + img.offset, img.w, img.h,
+               sx - (int)(img.ax * k), bottomY - (int)(img.ay * k), w, h, clipY, BB_KEY);
+}
@@ -0,0 +1,30 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  SCENERY BILLBOARDS
+  Pines, round trees and bushes pre-rasterized at startup into a
+  colour-keyed atlas, at BB_MIPS sizes for day and night. Drawing
+  one is a scaled span blit from the nearest larger mip instead of
+  the triangle/circle calls it was built from
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef BILLBOARD_H
+#define BILLBOARD_H
+
+#include <Arduino.h>
+
+#define BB_TYPES      3           // Sprite types 0..2 (pine, tree, bush)
+#define BB_MIPS       4           // Sizes per type, each half the previous
+#define BB_SCALE0     0.002f      // Projection scale mip 0 is rendered at
+#define BB_KEY        TFT_MAGENTA // Transparent atlas pixels
+
+// Rasterize every type, mip and time-of-day variant into the atlas.
+// Call once after the display is up; reports on Serial if it runs out
+// of room (the types that don't fit aren't drawn).
+void initBillboards();
+
+// Draw sprite type (0..BB_TYPES-1) standing on (sx, bottomY) at
+// projection scale, hiding rows at or below clipY
+void drawBillboard(int type, int sx, int bottomY, float scale, int clipY, bool night);
+
+#endif // BILLBOARD_H
@@ -9,7 +9,16 @@
   - utils.cpp/h    : Funciones utilitarias matemáticas
   - track.cpp/h    : Generación de pista y tráfico
   - rendering.cpp/h: Funciones de dibujo y renderizado
+  - sim.cpp/h      : Simulación sin dibujo (pista, jugador, tráfico)
   - physics.cpp/h  : Física del juego y colisiones
+  - gfx.cpp/h      : Capa del mundo a resolución completa o reducida
+  - displist.cpp/h : Lista de comandos del mundo, rasterizada por bandas en los dos núcleos
+  - arena.cpp/h    : Memoria temporal por frame (vértices, listas, comandos)
+  - memmap.cpp/h   : Mapa de memoria: buffers por región (SRAM/PSRAM/flash)
+  - input.cpp/h    : Botones muestreados por timer, antirrebote y latencia
+  - profiler.cpp/h : Tiempos por etapa del frame y overlay
+  - governor.cpp/h : Calidad de render según el presupuesto de frame
+  - bench_prims.cpp/h: Micro-benchmark de primitivas (PRIM_BENCH)
   ═══════════════════════════════════════════════════════════════
 */
 
@@ -23,6 +32,15 @@
 #include "track.h"
 #include "rendering.h"
 #include "physics.h"
+#include "render_text.h"
+#include "bench_prims.h"
+#include "profiler.h"
+#include "governor.h"
+#include "billboard.h"
+#include "displist.h"
+#include "arena.h"
+#include "memmap.h"
+#include "input.h"
 
 // ═══════════════════════════════════════════════════════════════
 //  VARIABLES DE CONTROL DE TIEMPO Y DÍA/NOCHE
@@ -36,9 +54,6 @@ long distSinceTimeChange = 0;
 void setup() {
   Serial.begin(115200);
 
-  // Configurar pines de botones
-  pinMode(BTN_LEFT,  INPUT_PULLUP);
-  pinMode(BTN_RIGHT, INPUT_PULLUP);
   randomSeed(analogRead(0));
 
   // Configurar backlight de la pantalla
@@ -56,34 +71,64 @@ void setup() {
   if (spr.createSprite(SCR_W, SCR_H) == nullptr) {
     Serial.println("ERROR: Fallo al crear spr principal!");
   }
+  // Se escribe fila a fila y es demasiado grande para la SRAM
+  memRegisterSprite("spr", "main", spr, MEM_PSRAM, false);
 
-  // Inicializar física
-  initPhysics();
+  // Capa del mundo (cielo, carretera, edificios, tráfico): a resolución
+  // completa va directo a spr; a media resolución usa un buffer en SRAM
+  // que se duplica al enviar a la pantalla. Con WORLD_INDEXED el buffer
+  // guarda índices de paleta de 8 bits y se expande a RGB565 al enviar
+  setWorldRes(WORLD_RES);
+  setWorldIndexed(WORLD_INDEXED);
 
-  // DEBUG DE PSRAM
-  Serial.print("Total PSRAM: "); Serial.println(ESP.getPsramSize());
-  Serial.print("Free PSRAM:  "); Serial.println(ESP.getFreePsram());
+  // Inicializar física: construye pista y tráfico con su propio PRNG
+  // (la misma semilla da la misma carrera en el ESP32 y en el PC)
+  initPhysics((uint32_t)random(1, 0x7FFFFFFF));
 
   // Inicializar colores
   initColors(timeOfDay);
 
+#if PRIM_BENCH
+  // Modo benchmark: medir las primitivas de dibujo, imprimir por Serial
+  // y quedarse aquí (el juego no arranca)
+  runPrimBench();
+  while (true) delay(1000);
+#endif
+
+  // Lista de comandos del mundo: con DL_THREADS > 0 las primitivas del
+  // mundo se graban y se rasterizan por bandas en paralelo (núcleo 0 y 1)
+  dlSetThreads(DL_THREADS);
+
+  // Construir los atlas de glifos del texto y pre-renderizar las capas
+  // estáticas del HUD (velocímetro, panel de vuelta)
+  initText();
+  initHUD();
+
   // ¡NUEVO! Generar montañas parallax en PSRAM
   initBackground();
 
-  // Construir pista
-  buildTrack();
-
-  // Inicializar tráfico
-  initTraffic(maxSpeed);
+  // Pre-renderizar pinos, árboles y arbustos en el atlas de billboards
+  initBillboards();
+  initPlayerCar();
 
   // Mostrar pantalla de inicio con carro rotando (3 segundos)
   unsigned long startTime = millis();
   while (millis() - startTime < 3000) {
     float animTime = (millis() - startTime) * 0.001f; // Convertir a segundos
+    frameReset();
     drawStartScreen(animTime);
     delay(16); // ~60 FPS
   }
 
+  // Botones: muestreo a INPUT_SAMPLE_HZ fuera del loop, con antirrebote,
+  // a una cola con marca de tiempo que la física consume tick a tick.
+  // Empieza aquí para que la pantalla de inicio no deje pulsaciones viejas
+  initInput();
+
+  // Tabla de memoria: cada buffer con su tamaño, región y dueño
+  // (avisa si un buffer del camino caliente quedó en PSRAM)
+  memReport();
+
   lastFrameMs = millis();
   distSinceTimeChange = 0;
 }
@@ -92,46 +137,63 @@ void setup() {
 //  MAIN LOOP
 // ═══════════════════════════════════════════════════════════════
 void loop() {
+  profFrameBegin();
+  frameReset();   // Memoria temporal del frame anterior (arena.h) libre de nuevo
+
   unsigned long now = millis();
-  float dt = (now - lastFrameMs) / 1000.0;
+  float frameDt = (now - lastFrameMs) / 1000.0f;
   lastFrameMs = now;
-  if (dt > 0.1) dt = 0.1; // Limitar delta time
 
-  // Actualizar juego si no está crashed
-  if (!crashed) {
-    handleInput(dt);
-    updatePhysics(dt);
-    checkCollisions();
+  // Simulación a paso fijo (SIM_HZ) desacoplada del framerate: entrada,
+  // física, colisiones y recuperación de choques avanzan en ticks enteros
+  float alpha = stepSimulation(frameDt);
+  interpolateRenderState(alpha);
 
+  if (!crashed) {
     // --- MAGIA DEL PARALLAX ---
     // El fondo se mueve según la curva y velocidad (efecto Horizon Chase)
-    int pSeg = findSegIdx(position + playerZdist);
+    int pSeg = findSegIdx(renderPosition + playerZdist);
     float curveForce = segments[pSeg].curve;
     // Factor 150.0 controla velocidad de rotación del fondo
-    skyOffset += curveForce * (speed / maxSpeed) * 150.0f * dt;
+    skyOffset += curveForce * (speed / maxSpeed) * 150.0f * frameDt;
   }
+  profMark(PROF_SIM);
+
+  // Renderizar frame en el sprite (buffer), con el estado interpolado
+  drawSky(renderPosition, playerZdist, timeOfDay, skyOffset);
+  profMark(PROF_SKY);
+  drawRoad(renderPosition, renderPlayerX, playerZdist, cameraDepth, timeOfDay);
+  dlFlush();   // Con la lista de comandos, aquí se rasteriza el mundo
+  profMark(PROF_ROAD);
 
-  // Renderizar frame en el sprite (buffer)
-  drawSky(position, playerZdist, timeOfDay, skyOffset);
-  drawRoad(position, playerX, playerZdist, cameraDepth, timeOfDay);
+  // Coche y HUD siempre a resolución completa, encima del mundo
+  beginOverlay();
   drawPlayerCar();
+  profMark(PROF_CAR);
   drawHUD(speed, maxSpeed, currentLapTime, bestLapTime);
 
   // Mostrar mensaje de crash
-  if (crashed) {
-    drawCrashMessage();
-    if (millis() - crashTimer > 2000) {
-      crashed = false;
-      speed   = 0;
-      playerX = 0;
-    }
-  }
+  if (crashed) drawCrashMessage();
+
+  // Overlay del profiler (tiempos por etapa y nivel de calidad)
+  drawProfiler(spr);
+  profMark(PROF_HUD);
+
+  // Enviar el frame completo a la pantalla (double buffering); a media
+  // resolución aquí se duplican líneas/píxeles y se compone el overlay
+  presentFrame();
+  inputFramePresented();   // Sonda de latencia: pulsación -> primer frame que la muestra
+  profMark(PROF_PUSH);
+  profFrameEnd();
 
-  // Enviar el frame completo a la pantalla (double buffering)
-  spr.pushSprite(0, 0);
+#if GOVERNOR
+  // Ajustar distancia de dibujo, subdivisión de la carretera, detalle
+  // de edificios y LOD del coche para el próximo frame
+  updateGovernor();
+#endif
 
   // Cambiar hora del día según distancia recorrida
-  distSinceTimeChange += (int)(speed * dt);
+  distSinceTimeChange += (int)(speed * frameDt);
   if (distSinceTimeChange > 180000) {
     distSinceTimeChange = 0;
     timeOfDay = (timeOfDay + 1) % 3;
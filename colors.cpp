@@ -4,6 +4,7 @@
   ═══════════════════════════════════════════════════════════════
 */
 
+#include <atomic>
 #include "colors.h"
 #include <TFT_eSPI.h>
 
@@ -16,6 +17,14 @@ uint16_t colRoadL, colRoadD;
 uint16_t colRumbleL, colRumbleD;
 uint16_t colLane, colFog;
 
+uint16_t colPalette[PALETTE_SIZE];
+uint16_t paletteVersion = 0;
+
+// Direct-mapped colorIndex() memo: (1 << 24) | (c << 8) | index, 0 = empty.
+// Entries are self-checking, so display list threads can share it
+#define INDEX_CACHE   512
+static std::atomic<uint32_t> indexCache[INDEX_CACHE];
+
 // ═══════════════════════════════════════════════════════════════
 //  FUNCTION IMPLEMENTATION
 // ═══════════════════════════════════════════════════════════════
@@ -41,6 +50,59 @@ uint16_t lerpCol(uint16_t c1, uint16_t c2, float t) {
           ((int)(b1 + (b2 - b1) * t) & 0x1F);
 }
 
+// ═══════════════════════════════════════════════════════════════
+//  INDEXED PALETTE
+// ═══════════════════════════════════════════════════════════════
+
+static void buildPalette() {
+  // Colours the road renderer fades with distance (worn road is the
+  // road darkened 10%, see drawRoadRows)
+  const uint16_t fogged[] = {
+    colGrassL, colGrassD, colRoadL, colRoadD,
+    lerpCol(colRoadL, 0, 0.1f), lerpCol(colRoadD, 0, 0.1f),
+    colRumbleL, colRumbleD, colLane
+  };
+  int n = 0;
+  for (uint16_t base : fogged)
+    for (int k = 0; k < FOG_RAMP; k++)
+      colPalette[n++] = lerpCol(base, colFog, (float)k / FOG_RAMP);
+  colPalette[n++] = colFog;
+
+  // Greys between the cube's black, mid grey and white
+  for (int k = 1; k <= 8; k++) {
+    uint8_t v = k * 255 / 9;
+    colPalette[n++] = rgb(v, v, v);
+  }
+
+  // 5x7x5 cube fills the rest: 73 + 8 + 175 = 256
+  for (int r = 0; r < 5; r++)
+    for (int g = 0; g < 7; g++)
+      for (int b = 0; b < 5; b++)
+        colPalette[n++] = rgb(r * 255 / 4, g * 255 / 6, b * 255 / 4);
+
+  for (auto& e : indexCache) e.store(0, std::memory_order_relaxed);
+  paletteVersion++;
+}
+
+uint8_t colorIndex(uint16_t c) {
+  uint32_t slot = ((c * 40503u) >> 7) & (INDEX_CACHE - 1);
+  uint32_t e = indexCache[slot].load(std::memory_order_relaxed);
+  if ((e >> 8) == (0x10000u | c)) return (uint8_t)e;
+
+  // Miss: weighted squared distance over 8-bit channels
+  int r = (c >> 8) & 0xF8, g = (c >> 3) & 0xFC, b = (c << 3) & 0xF8;
+  int best = 0;
+  int32_t bestD = INT32_MAX;
+  for (int i = 0; i < PALETTE_SIZE; i++) {
+    uint16_t p = colPalette[i];
+    int dr = ((p >> 8) & 0xF8) - r, dg = ((p >> 3) & 0xFC) - g, db = ((p << 3) & 0xF8) - b;
+    int32_t d = 3 * dr * dr + 4 * dg * dg + 2 * db * db;
+    if (d < bestD) { bestD = d; best = i; if (d == 0) break; }
+  }
+  indexCache[slot].store(0x1000000u | ((uint32_t)c << 8) | best, std::memory_order_relaxed);
+  return (uint8_t)best;
+}
+
 void initColors(int timeOfDay) {
   switch (timeOfDay) {
     case 0: // Day
@@ -83,4 +145,5 @@ void initColors(int timeOfDay) {
       colFog     = rgb(15, 15, 40);
       break;
   }
+  buildPalette();
 }
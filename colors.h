@@ -18,6 +18,18 @@ extern uint16_t colRoadL, colRoadD;
 extern uint16_t colRumbleL, colRumbleD;
 extern uint16_t colLane, colFog;
 
+// ═══════════════════════════════════════════════════════════════
+//  INDEXED PALETTE
+//  256 RGB565 entries for the 8-bit world layer (gfx.h): each road
+//  and grass colour faded towards colFog in FOG_RAMP steps, a grey
+//  ramp and a 5x7x5 colour cube for everything else
+// ═══════════════════════════════════════════════════════════════
+#define PALETTE_SIZE  256
+#define FOG_RAMP      8           // Palette steps from a base colour to colFog
+
+extern uint16_t colPalette[PALETTE_SIZE];
+extern uint16_t paletteVersion;   // Bumped each time initColors() rebuilds it
+
 // ═══════════════════════════════════════════════════════════════
 //  FUNCTIONS
 // ═══════════════════════════════════════════════════════════════
@@ -31,7 +43,10 @@ uint16_t darkenCol(uint16_t c, float f);
 // Interpolate between two colors
 uint16_t lerpCol(uint16_t c1, uint16_t c2, float t);
 
-// Initialize colors based on time of day
+// Initialize colors based on time of day (also rebuilds colPalette)
 void initColors(int timeOfDay);
 
+// Nearest colPalette entry to an RGB565 colour (memoized)
+uint8_t colorIndex(uint16_t c);
+
 #endif // COLORS_H
@@ -23,6 +23,9 @@
 #define SCR_H       240
 #define SCR_CX      (SCR_W / 2)
 #define SCR_CY      (SCR_H / 2)
+#define WORLD_RES   0         // World layer: 0 = 320x240, 1 = 320x120, 2 = 160x120 (gfx.h)
+#define WORLD_INDEXED 0       // 1 = world layer as 8-bit palette indices (gfx.h)
+#define DL_THREADS  0         // World display list raster threads, 0 = draw immediately (displist.h)
 
 // ═══════════════════════════════════════════════════════════════
 //  GAME CONSTANTS
@@ -30,16 +33,38 @@
 #define SEG_LEN     200       // Length of each segment
 #define RUMBLE_LEN  3         // Length of rumble strips
 #define DRAW_DIST   40        // Draw distance
-#define TOTAL_SEGS  200       // Total segments on the track (RAM optimized)
+#define FAR_DIST    80        // Far field past DRAW_DIST: road and grass only, merged spans
+#define FAR_STEP_MAX 8        // Max segments merged into one far-field span
+#define FAR_TIER    8         // Far spans per merge step before the step doubles
+#define TOTAL_SEGS  200       // Total segments on the track (> DRAW_DIST + FAR_DIST)
 #define ROAD_W      2000      // Road width
 #define LANES       3         // Number of lanes
 #define FOV_DEG     100       // Field of view in degrees
 #define CAM_HEIGHT  1000      // Camera height
 #define FOG_DENSITY 5         // Fog density
+#define RACE_LAPS   3         // Laps per race (counter wraps to 1 after the last)
 
 // 1 = random track on startup, 0 = fixed track
 #define RANDOM_TRACK 1
 
+// ═══════════════════════════════════════════════════════════════
+//  SIMULATION TIMING
+// ═══════════════════════════════════════════════════════════════
+#define SIM_HZ             120     // Fixed physics tick rate (independent of FPS)
+#define SIM_DT             (1.0f / SIM_HZ)
+#define SIM_MAX_STEPS      12      // Max ticks per rendered frame, older backlog is dropped
+#define PHYS_REF_HZ        60.0f   // Rate the "per frame" constants below were tuned at
+#define CRASH_TICKS        (2 * SIM_HZ) // Crash recovery time (2 s)
+#define SEG_FX_SHIFT       16      // Fixed-point track position: 1 segment = 1 << 16 units
+#define SIM_SEED           0x5EEDu // Fallback race seed (the PRNG state must not be 0)
+
+// ═══════════════════════════════════════════════════════════════
+//  INPUT
+// ═══════════════════════════════════════════════════════════════
+#define INPUT_SAMPLE_HZ    1000    // Button sampling rate, off the frame loop (input.h)
+#define INPUT_DEBOUNCE     5       // Equal samples in a row before a button change counts (5 ms)
+#define INPUT_DEMO_MS      8000    // Autopilot drives again this long after the last button
+
 // ═══════════════════════════════════════════════════════════════
 //  CAR PHYSICS
 // ═══════════════════════════════════════════════════════════════
@@ -47,14 +72,16 @@
 #define ACCEL_TARGET       0.9f    // targetAccel = maxSpeed * ACCEL_TARGET
 #define ACCEL_RAMP         180.0f  // How fast acceleration ramps up (u/s²)
 #define ACCEL_NEAR_MAX     0.90f   // Speed threshold to reduce acceleration
-#define ACCEL_DAMPING      0.97f   // Multiplier when approaching maxSpeed
-#define FRICTION           0.996f  // Friction per frame (braking ~3.3s from max)
+#define ACCEL_DAMPING      0.97f   // Multiplier per reference frame when approaching maxSpeed
+#define FRICTION           0.996f  // Friction per reference frame (braking ~3.3s from max)
 #define GRAVITY_FACTOR     1600.0f // Effect of slopes on acceleration
 #define CENTRIFUGAL        0.18f   // Centrifugal force in curves
 #define CURVE_FORCE        3.0f    // Lateral force multiplier in curves
-#define LATERAL_FRICTION   0.90f   // Lateral velocity damping per frame
+#define LATERAL_FRICTION   0.90f   // Lateral velocity damping per reference frame
 #define STEER_AUTO         1.8f    // Autopilot response to curves
+#define STEER_RATE         1.2f    // Lateral speed at full manual steer (road half-widths/s)
 #define CENTRIFUGAL_DX     1.5f    // Lateral centrifugal push factor
+#define DRIFT_DECAY        0.9f    // Drift angle decay per reference frame when stopped
 
 // ═══════════════════════════════════════════════════════════════
 //  BUILDINGS
@@ -63,14 +90,47 @@
 #define BUILDING_H_MAX     350000  // Maximum building height (~30 floors)
 #define BUILDING_W         400000  // Base building width
 #define BUILDING_OFFSET    1.5f    // Distance from road edge
-#define BUILDING_SEG_MIN   6       // Minimum segments per block
-#define BUILDING_SEG_MAX   16      // Maximum segments per block
-#define BUILDING_GAP_MIN   10      // Minimum gap segments between blocks
-#define BUILDING_GAP_MAX   20      // Maximum gap segments between blocks
+#define BUILDING_SEG_MIN   6       // Minimum segments per building
+#define BUILDING_SEG_MAX   16      // Maximum segments per building
+#define BUILDING_GAP_MIN   10      // Minimum gap segments between buildings
+#define BUILDING_BLOCK     (BUILDING_GAP_MIN + BUILDING_SEG_MAX) // Segments per block: gap, then building
+#define BUILDING_CHANCE    8       // Blocks in 10 that hold a building
+#define BUILDING_STYLES    6       // Window patterns (drawBuilding)
 
 // ═══════════════════════════════════════════════════════════════
 //  TRAFFIC
 // ═══════════════════════════════════════════════════════════════
 #define MAX_CARS 6
 
+// ═══════════════════════════════════════════════════════════════
+//  PLAYER CAR IMPOSTORS
+// ═══════════════════════════════════════════════════════════════
+#define CAR_IMPOSTORS      1       // 1 = draw the car from cached pre-rendered views
+#define IMP_YAW_BINS       33      // Views over -IMP_YAW_MAX .. IMP_YAW_MAX
+#define IMP_YAW_MAX        1.2f    // rotY = playerX * 0.5, off-road edge included
+#define IMP_PITCH_BINS     11      // Views over IMP_PITCH_MIN .. IMP_PITCH_MAX, 0.05 apart:
+#define IMP_PITCH_MIN      0.03f   // 0.28 base pitch -/+ the 0.25 road pitch clamp, so the
+#define IMP_PITCH_MAX      0.53f   // middle bin is the flat-road pose exactly
+#define IMP_CACHE_BYTES    (1024UL * 1024) // PSRAM block reserved at boot; views past it draw the mesh
+#define IMP_KEY            TFT_MAGENTA     // Transparent pixels of a captured view
+
+// ═══════════════════════════════════════════════════════════════
+//  FRAME-BUDGET GOVERNOR AND PROFILER
+// ═══════════════════════════════════════════════════════════════
+#define GOVERNOR           1       // 1 = scale render quality to hold FRAME_BUDGET_US
+#define FRAME_BUDGET_US    33333   // Target frame time in µs (30 FPS)
+#define GOV_DOWN_FRAMES    6       // Frames over budget in a row before dropping a level
+#define GOV_UP_FRAMES      45      // Frames with headroom in a row before raising a level
+#define GOV_UP_COST        0.25f   // Expected growth of road + car time one level up
+#define GOV_UP_HEADROOM    0.85f   // Raise only if that predicted frame fits in this budget share
+#define PROFILER_OVERLAY   0       // 1 = show stage times and quality level on screen
+#ifndef DRAW_STATS
+#define DRAW_STATS         0       // 1 = count draw calls and pixels per render stage (drawstats.h)
+#endif
+
+// ═══════════════════════════════════════════════════════════════
+//  BENCHMARKS
+// ═══════════════════════════════════════════════════════════════
+#define PRIM_BENCH         0       // 1 = run the primitive micro-benchmark at boot instead of the game
+
 #endif // CONFIG_H
@@ -0,0 +1,190 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  WORLD DISPLAY LIST IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+// Standard headers first: the emulator's Arduino.h defines min/max/abs
+// as macros, which break them
+#include <atomic>
+#ifndef ARDUINO
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdlib>
+#endif
+
+#include "displist.h"
+#include "memmap.h"
+
+uint8_t dlThreads = 0;
+
+static GfxCmd   cmds[DL_MAX_CMDS];
+static int      cmdCount = 0;
+static int      refCount = 0;               // Sum of tiles touched by the commands
+
+// Commands of tile t are binRefs[binStart[t] .. binStart[t + 1] - 1]
+static uint16_t binStart[DL_MAX_TILES + 1];
+static uint16_t binRefs[DL_MAX_REFS];
+static int      tileCount = 0, layerRows = 0;
+static std::atomic<int> nextTile(0);
+
+static int workers = 0;                     // Threads besides the caller's
+
+// ═══════════════════════════════════════════════════════════════
+//  RASTERIZATION
+// ═══════════════════════════════════════════════════════════════
+
+static void rasterTile(int t) {
+  int lo = t * DL_TILE_ROWS;
+  int hi = min(lo + DL_TILE_ROWS, layerRows) - 1;
+  for (int i = binStart[t]; i < binStart[t + 1]; i++) gfxExec(cmds[binRefs[i]], lo, hi);
+}
+
+// Take tiles until none are left (run by the caller and every worker)
+static void runTiles() {
+  for (int t; (t = nextTile.fetch_add(1)) < tileCount;) rasterTile(t);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  WORKERS
+// ═══════════════════════════════════════════════════════════════
+
+#ifdef ARDUINO
+
+static TaskHandle_t      dlTask = nullptr;
+static SemaphoreHandle_t dlDone = nullptr;
+
+static void dlTaskMain(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    runTiles();
+    xSemaphoreGive(dlDone);
+  }
+}
+
+// loop() runs on core 1; the helper sits on core 0 (the task stays
+// parked when the display list is turned down again)
+static void startWorkers(int n) {
+  workers = 0;
+  if (n < 1) return;
+  if (!dlTask) {
+    dlDone = xSemaphoreCreateBinary();
+    if (!dlDone || xTaskCreatePinnedToCore(dlTaskMain, "dlRaster", 4096, nullptr, 1, &dlTask, 0) != pdPASS) {
+      Serial.println("ERROR: Failed to start the display list task");
+      dlTask = nullptr;
+      return;
+    }
+  }
+  workers = 1;
+}
+
+static void runWorkers() {
+  if (workers) xTaskNotifyGive(dlTask);
+  runTiles();
+  if (workers) xSemaphoreTake(dlDone, portMAX_DELAY);
+}
+
+#else
+
+static std::thread             pool[DL_MAX_THREADS];
+static std::mutex              poolMx;
+static std::condition_variable poolCv, doneCv;
+static uint32_t                poolGen = 0;     // Bumped once per flush
+static int                     poolBusy = 0;    // Workers still on this flush
+static bool                    poolQuit = false;
+
+static void workerMain(uint32_t seen) {
+  std::unique_lock<std::mutex> lk(poolMx);
+  for (;;) {
+    poolCv.wait(lk, [&] { return poolQuit || poolGen != seen; });
+    if (poolQuit) return;
+    seen = poolGen;
+    lk.unlock();
+    runTiles();
+    lk.lock();
+    if (--poolBusy == 0) doneCv.notify_one();
+  }
+}
+
+static void stopWorkers() {
+  {
+    std::lock_guard<std::mutex> lk(poolMx);
+    poolQuit = true;
+  }
+  poolCv.notify_all();
+  for (int i = 0; i < workers; i++) pool[i].join();
+  poolQuit = false;
+  workers = 0;
+}
+
+// The pool is joined at exit too: destroying a condition variable that
+// parked workers still wait on never returns
+static void startWorkers(int n) {
+  static bool joinAtExit = false;
+  stopWorkers();
+  if (n > 0 && !joinAtExit) joinAtExit = !atexit(stopWorkers);
+  workers = max(n, 0);
+  for (int i = 0; i < workers; i++) pool[i] = std::thread(workerMain, poolGen);
+}
+
+static void runWorkers() {
+  if (workers) {
+    std::lock_guard<std::mutex> lk(poolMx);
+    poolBusy = workers;
+    poolGen++;
+  }
+  poolCv.notify_all();
+  runTiles();
+  if (workers) {
+    std::unique_lock<std::mutex> lk(poolMx);
+    doneCv.wait(lk, [] { return poolBusy == 0; });
+  }
+}
+
+#endif
+
+// ═══════════════════════════════════════════════════════════════
+//  RECORDING
+// ═══════════════════════════════════════════════════════════════
+
+void dlSetThreads(uint8_t n) {
+  dlFlush();
+  memRegister("dlCmds", "displist", cmds, sizeof(cmds) + sizeof(binRefs), MEM_SRAM, true);
+  n = min(n, (uint8_t)DL_MAX_THREADS);
+  startWorkers(n - 1);
+  dlThreads = n;
+}
+
+static inline int tilesOf(const GfxCmd& k) {
+  return k.y1 / DL_TILE_ROWS - k.y0 / DL_TILE_ROWS + 1;
+}
+
+void dlRecord(const GfxCmd& k) {
+  if (k.y0 > k.y1) return;
+  if (cmdCount == DL_MAX_CMDS || refCount + tilesOf(k) > DL_MAX_REFS) dlFlush();
+  cmds[cmdCount++] = k;
+  refCount += tilesOf(k);
+}
+
+// Counting sort of the commands into tiles, keeping recording order
+// within each tile, then every thread takes tiles until none are left
+void dlFlush() {
+  if (cmdCount == 0) return;
+  layerRows = gfxLayerRows();
+  tileCount = min((layerRows + DL_TILE_ROWS - 1) / DL_TILE_ROWS, DL_MAX_TILES);
+
+  memset(binStart, 0, sizeof(binStart));
+  for (int i = 0; i < cmdCount; i++)
+    for (int t = cmds[i].y0 / DL_TILE_ROWS; t <= cmds[i].y1 / DL_TILE_ROWS; t++) binStart[t + 1]++;
+  for (int t = 0; t < tileCount; t++) binStart[t + 1] += binStart[t];
+  uint16_t fill[DL_MAX_TILES];
+  memcpy(fill, binStart, sizeof(fill));
+  for (int i = 0; i < cmdCount; i++)
+    for (int t = cmds[i].y0 / DL_TILE_ROWS; t <= cmds[i].y1 / DL_TILE_ROWS; t++) binRefs[fill[t]++] = i;
+
+  nextTile.store(0);
+  runWorkers();
+
+  cmdCount = refCount = 0;
+}
@@ -0,0 +1,69 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  WORLD DISPLAY LIST
+  With dlThreads > 0 the world primitives (gfx.h) don't touch the
+  frame: each one appends a compact command to a per-frame list.
+  dlFlush() bins the commands into bands of DL_TILE_ROWS rows and
+  rasterizes the bands in parallel (a thread pool on the host, a
+  task on the other core on the ESP32). Each band replays its
+  commands in recording order clipped to its own rows, so the
+  painter's order is kept and no two threads write the same pixel.
+  Bands span the full width because nearly every world command does
+  (road rows, sky, far field). The player car and HUD still draw
+  straight into spr after the flush
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef DISPLIST_H
+#define DISPLIST_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#define DL_TILE_ROWS    16        // World rows per tile
+#define DL_MAX_TILES    16        // 240 / DL_TILE_ROWS
+#define DL_MAX_CMDS     1024      // Commands per flush
+#define DL_MAX_REFS     4096      // Tile references per flush
+#ifdef ARDUINO
+#define DL_MAX_THREADS  2         // One per core
+#else
+#define DL_MAX_THREADS  16
+#endif
+
+// World primitive, in world-layer coordinates with the colour already
+// in the layer's pixel format
+enum GfxOp : uint8_t {
+  OP_RECT, OP_LINE, OP_PIXEL, OP_TRI, OP_CIRCLE, OP_ELLIPSE, OP_RING,
+  OP_ELLIPSE_RING, OP_SPANS, OP_TRAP_H, OP_TRAP_V, OP_BLIT, OP_BACKGROUND
+};
+
+struct GfxCmd {
+  uint8_t     op;
+  int16_t     y0, y1;     // Rows touched (clamped to the layer), for binning
+  uint16_t    c;          // Byte-swapped RGB565 or palette index
+  int32_t     a[7];       // Op arguments (see gfx.cpp)
+#if DRAW_STATS
+  uint8_t     stage;      // DrawStage that recorded it (drawstats.h)
+#endif
+  const void* p;          // OP_SPANS: span list in the frame arena; OP_BLIT, OP_BACKGROUND: source pixels
+  const void* q;          // OP_BACKGROUND: indexed copy of the source, or nullptr
+};
+
+extern uint8_t dlThreads;             // 0 = world primitives draw immediately
+
+// Turn the display list on with n raster threads (the caller's included,
+// clamped to DL_MAX_THREADS) or off with 0. Pending commands are drawn first.
+void dlSetThreads(uint8_t n);
+
+// Append a command; flushes first if the list is full
+void dlRecord(const GfxCmd& cmd);
+
+// Rasterize and clear everything recorded so far
+void dlFlush();
+
+// Provided by gfx.cpp: rows in the world layer, and drawing one command
+// into rows lo..hi of it
+int  gfxLayerRows();
+void gfxExec(const GfxCmd& cmd, int lo, int hi);
+
+#endif // DISPLIST_H
@@ -0,0 +1,42 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  DRAW-CALL AND PIXEL COUNTERS IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+// Standard headers first: the emulator's Arduino.h defines min/max/abs
+// as macros, which break them
+#include <atomic>
+
+#include "drawstats.h"
+
+const char* const dsStageNames[DS_STAGES] = {
+  "OTHR", "SKY ", "FAR ", "ROAD", "TUNL", "BLDG", "SCEN", "TRAF", "CAR ", "HUD "
+};
+
+static DrawCount last[DS_STAGES];
+
+const DrawCount& dsFrame(DrawStage s) {
+  return last[s];
+}
+
+#if DRAW_STATS
+
+uint8_t dsStage = DS_OTHER;
+
+static std::atomic<uint32_t> curCalls[DS_STAGES][DP_PRIMS];
+static std::atomic<uint32_t> curPixels[DS_STAGES];
+
+void dsCount(uint8_t s, uint8_t prim, uint32_t calls, uint32_t pixels) {
+  curCalls[s][prim].fetch_add(calls, std::memory_order_relaxed);
+  curPixels[s].fetch_add(pixels, std::memory_order_relaxed);
+}
+
+void dsFrameEnd() {
+  for (int s = 0; s < DS_STAGES; s++) {
+    for (int p = 0; p < DP_PRIMS; p++) last[s].calls[p] = curCalls[s][p].exchange(0, std::memory_order_relaxed);
+    last[s].pixels = curPixels[s].exchange(0, std::memory_order_relaxed);
+  }
+}
+
+#endif
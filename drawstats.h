@@ -0,0 +1,154 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  DRAW-CALL AND PIXEL COUNTERS
+  With DRAW_STATS set (config.h) every primitive is counted against
+  the render stage that issued it: calls by kind, and pixels
+  written. World primitives are counted in gfx.cpp (pixels exactly,
+  as the rasterizers write them, in world-layer pixels); the player
+  car and HUD call the sprite through DS_SPR(), which counts and
+  forwards. With DRAW_STATS at 0 the macros are empty and DS_SPR(s)
+  is just s
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef DRAWSTATS_H
+#define DRAWSTATS_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "config.h"
+
+// Render stages, set by the renderers (DS_STAGE / DS_SET_STAGE)
+enum DrawStage : uint8_t {
+  DS_OTHER,     // Outside any stage (start screen, crash message)
+  DS_SKY,       // Parallax background
+  DS_FAR,       // Road pass 1: ground fill and far field
+  DS_ROAD,      // Road pass 2: road rows
+  DS_TUNNEL,    // Tunnel walls, ceilings and mouths
+  DS_BUILDING,  // Building walls, roofs, windows
+  DS_SCENERY,   // Road pass 3: roadside billboards
+  DS_TRAFFIC,   // Traffic car faces
+  DS_CAR,       // Player car (mesh, impostor, shadow)
+  DS_HUD,       // Dial, lap panel, overlays
+  DS_STAGES
+};
+
+// Primitive kinds
+enum DrawPrim : uint8_t {
+  DP_RECT,      // fillRect, fast lines, span runs
+  DP_TRI,       // fillTriangle, trapezoids
+  DP_PIXEL,     // drawPixel
+  DP_OTHER,     // Lines, circles, blits, sprite pushes, text
+  DP_PRIMS
+};
+
+struct DrawCount {
+  uint32_t calls[DP_PRIMS];
+  uint32_t pixels;
+};
+
+// Counts of the last finished frame (all zero with DRAW_STATS off)
+const DrawCount& dsFrame(DrawStage s);
+extern const char* const dsStageNames[DS_STAGES];
+
+#if DRAW_STATS
+
+extern uint8_t dsStage;               // Stage the next primitives count against
+
+// Add to stage s (safe from the display list's raster threads)
+void dsCount(uint8_t s, uint8_t prim, uint32_t calls, uint32_t pixels);
+
+// Close the frame: its counts become dsFrame() and counting restarts
+void dsFrameEnd();
+
+// Stage for the rest of the enclosing scope
+struct DrawStageScope {
+  uint8_t prev;
+  DrawStageScope(uint8_t s) : prev(dsStage) { dsStage = s; }
+  ~DrawStageScope() { dsStage = prev; }
+};
+#define DS_STAGE(s)       DrawStageScope dsScope_(s)
+#define DS_SET_STAGE(s)   (dsStage = (s))
+
+// Counting stand-in for a sprite; pixels of circles, triangles and
+// pushes are their clipped bounding area or geometric area, not a scan
+class StatSprite {
+public:
+  explicit StatSprite(TFT_eSprite& s) : s(s) {}
+
+  void fillSprite(uint16_t c) {
+    count(DP_RECT, (uint32_t)s.width() * s.height());
+    s.fillSprite(c);
+  }
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t c) {
+    count(DP_RECT, clipArea(x, y, w, h));
+    s.fillRect(x, y, w, h, c);
+  }
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t c) {
+    count(DP_OTHER, 2 * (max(w, (int32_t)0) + max(h, (int32_t)0)));
+    s.drawRect(x, y, w, h, c);
+  }
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t c) {
+    count(DP_RECT, clipArea(x, y, w, 1));
+    s.drawFastHLine(x, y, w, c);
+  }
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t c) {
+    count(DP_OTHER, max(abs(x1 - x0), abs(y1 - y0)) + 1);
+    s.drawLine(x0, y0, x1, y1, c);
+  }
+  void drawPixel(int32_t x, int32_t y, uint16_t c) {
+    count(DP_PIXEL, clipArea(x, y, 1, 1));
+    s.drawPixel(x, y, c);
+  }
+  void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                    int32_t x2, int32_t y2, uint16_t c) {
+    int32_t cross = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+    count(DP_TRI, abs(cross) / 2);
+    s.fillTriangle(x0, y0, x1, y1, x2, y2, c);
+  }
+  void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t c) {
+    count(DP_OTHER, (uint32_t)(3 * r * r + 2 * r + 1));
+    s.fillCircle(x, y, r, c);
+  }
+  void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t c) {
+    count(DP_OTHER, (uint32_t)(6 * r + 1));
+    s.drawCircle(x, y, r, c);
+  }
+  void fillEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint16_t c) {
+    count(DP_OTHER, (uint32_t)(3 * rx * ry + rx + ry + 1));
+    s.fillEllipse(x, y, rx, ry, c);
+  }
+  void pushToSprite(TFT_eSprite* d, int32_t x, int32_t y) {
+    count(DP_OTHER, (uint32_t)s.width() * s.height());
+    s.pushToSprite(d, x, y);
+  }
+  void pushToSprite(TFT_eSprite* d, int32_t x, int32_t y, uint16_t transparent) {
+    count(DP_OTHER, (uint32_t)s.width() * s.height());
+    s.pushToSprite(d, x, y, transparent);
+  }
+
+private:
+  TFT_eSprite& s;
+
+  void count(uint8_t prim, uint32_t pixels) { dsCount(dsStage, prim, 1, pixels); }
+  uint32_t clipArea(int32_t x, int32_t y, int32_t w, int32_t h) {
+    int32_t x1 = min(x + w, (int32_t)s.width()), y1 = min(y + h, (int32_t)s.height());
+    x = max(x, (int32_t)0);
+    y = max(y, (int32_t)0);
+    return (x1 > x && y1 > y) ? (uint32_t)((x1 - x) * (y1 - y)) : 0;
+  }
+};
+#define DS_SPR(s)         StatSprite(s)
+#define DS_COUNT(prim, calls, pixels)  dsCount(dsStage, prim, calls, pixels)
+
+#else
+
+#define DS_STAGE(s)
+#define DS_SET_STAGE(s)
+#define DS_SPR(s)         (s)
+#define DS_COUNT(prim, calls, pixels)
+inline void dsFrameEnd() {}
+
+#endif
+
+#endif // DRAWSTATS_H
@@ -1,7 +1,6 @@
+#include <atomic>
 #include <chrono>
 #include <thread>
-#include "raylib.h"
-#include "../config.h"
 #include "SPI.h"
 #include "Arduino.h"
 
@@ -18,22 +17,38 @@ unsigned long millis() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time).count();
 }
 
+unsigned long micros() {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now - start_time).count();
+}
+
 void delay(unsigned long ms) {
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
+// Own generator instead of Raylib's, so headless tools get the same
+// sequence as the window build for a given seed
+static uint32_t randState = 1;
+
+static uint32_t nextRandom() {
+    randState ^= randState << 13;
+    randState ^= randState >> 17;
+    randState ^= randState << 5;
+    return randState;
+}
+
 void randomSeed(long seed) {
-    SetRandomSeed(seed);
+    randState = seed ? (uint32_t)seed : 1;
 }
 
 int random(int max) {
-    if (max == 0) return 0;
-    return GetRandomValue(0, max - 1);
+    if (max <= 0) return 0;
+    return (int)(nextRandom() % (uint32_t)max);
 }
 
 int random(int min, int max) {
     if (min >= max) return min;
-    return GetRandomValue(min, max - 1);
+    return min + (int)(nextRandom() % (uint32_t)(max - min));
 }
 
 int analogRead(uint8_t pin) {
@@ -48,15 +63,20 @@ void digitalWrite(uint8_t pin, uint8_t val) {
     // No-op
 }
 
-// Input handling mapping
-// config.h defines BTN_LEFT 17, BTN_RIGHT 16
-// INPUT_PULLUP: LOW is pressed, HIGH is released.
-int digitalRead(uint8_t pin) {
-    if (pin == BTN_LEFT) {
-        return IsKeyDown(KEY_LEFT) ? LOW : HIGH;
-    }
-    if (pin == BTN_RIGHT) {
-        return IsKeyDown(KEY_RIGHT) ? LOW : HIGH;
+// Input pins, set by the front end (main.cpp maps the arrow keys to
+// BTN_LEFT / BTN_RIGHT). INPUT_PULLUP: LOW is pressed, HIGH is released.
+// The button sampler (input.cpp) reads them from its own thread.
+static std::atomic<uint8_t> pinLevel[256];
+static std::atomic<bool> pinLevelInit(false);
+
+void emuSetPin(uint8_t pin, int level) {
+    if (!pinLevelInit) {
+        for (auto& l : pinLevel) l = HIGH;
+        pinLevelInit = true;
     }
-    return HIGH;
+    pinLevel[pin] = level ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pinLevelInit ? pinLevel[pin].load() : HIGH;
 }
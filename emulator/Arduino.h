@@ -28,6 +28,7 @@ using std::string;
 
 // Functions
 extern unsigned long millis();
+extern unsigned long micros();
 extern void delay(unsigned long ms);
 extern void randomSeed(long seed);
 extern int random(int max);
@@ -35,6 +36,10 @@ extern int random(int min, int max);
 extern int analogRead(uint8_t pin);
 extern void pinMode(uint8_t pin, uint8_t mode);
 extern void digitalWrite(uint8_t pin, uint8_t val);
+extern int digitalRead(uint8_t pin);
+
+// Emulator hook: level returned by digitalRead(pin) from now on
+extern void emuSetPin(uint8_t pin, int level);
 
 // Math
 #ifndef min
@@ -70,12 +75,17 @@ extern SerialMock Serial;
 #define PROGMEM
 #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
 #define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const unsigned int *)(addr))
 
 // ESP / PSRAM Mocks
 class ESPMock {
 public:
     uint32_t getPsramSize() { return 8 * 1024 * 1024; }
     uint32_t getFreePsram() { return 4 * 1024 * 1024; }
+    uint32_t getMinFreePsram() { return 4 * 1024 * 1024; }
+    uint32_t getHeapSize() { return 320 * 1024; }
+    uint32_t getFreeHeap() { return 160 * 1024; }
+    uint32_t getMinFreeHeap() { return 160 * 1024; }
 };
 extern ESPMock ESP;
 
@@ -1,18 +1,27 @@
 #include "TFT_eSPI.h"
-#include "raylib.h"
 #include <cmath>
 
-// Helper to convert RGB565 to Raylib Color
-Color r565(uint16_t c) {
-    int r = (c >> 11) * 255 / 31;
-    int g = ((c >> 5) & 0x3F) * 255 / 63;
-    int b = (c & 0x1F) * 255 / 31;
-    return (Color){(unsigned char)r, (unsigned char)g, (unsigned char)b, 255};
+// Sprites keep pixels byte-swapped, exactly like TFT_eSprite at 16 bpp
+static inline uint16_t swap16(uint16_t c) {
+    return (uint16_t)((c >> 8) | (c << 8));
 }
 
+// TFT_eSPI's colour reduction for 8 bpp sprites
+static inline uint8_t color16to8(uint16_t c) {
+    return (uint8_t)(((c & 0xE000) >> 8) | ((c & 0x0700) >> 6) | ((c & 0x0018) >> 3));
+}
+
+static inline uint16_t color8to16(uint8_t c) {
+    return (uint16_t)(((c & 0xE0) << 8) | ((c & 0x1C) << 6) | ((c & 0x03) << 3));
+}
+
+template <typename T> static inline void swapVal(T& a, T& b) { T t = a; a = b; b = t; }
+
 // ---------------- TFT_eSPI ----------------
 TFT_eSPI::TFT_eSPI(int w, int h) {
-    // Nothing special needed for now
+    _w = w;
+    _h = h;
+    _fb = new uint16_t[w * h]();
 }
 
 void TFT_eSPI::begin() {
@@ -24,197 +33,299 @@ void TFT_eSPI::setRotation(uint8_t r) {
 }
 
 void TFT_eSPI::fillScreen(uint16_t color) {
-    ClearBackground(r565(color));
+    for (int i = 0; i < _w * _h; i++) _fb[i] = color;
 }
 
-// ---------------- TFT_eSprite ----------------
+uint16_t TFT_eSPI::color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
 
- struct SpriteData {
-    RenderTexture2D texture;
-    bool created;
-};
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+    for (int32_t j = 0; j < h; j++) {
+        int32_t dy = y + j;
+        if (dy < 0 || dy >= _h) continue;
+        for (int32_t i = 0; i < w; i++) {
+            int32_t dx = x + i;
+            if (dx < 0 || dx >= _w) continue;
+            uint16_t c = data[j * w + i];
+            _fb[dy * _w + dx] = _swapBytes ? c : swap16(c);
+        }
+    }
+}
+
+// ---------------- TFT_eSprite ----------------
 
 TFT_eSprite::TFT_eSprite(TFT_eSPI *tft) {
-    texture = new SpriteData{0};
+    _tft = tft;
+    _img = nullptr;
+    _img8 = nullptr;
     _w = 0;
     _h = 0;
-    cursor_x = 0;
-    cursor_y = 0;
-    text_color = 0xFFFF;
-    text_size = 1;
 }
 
 TFT_eSprite::~TFT_eSprite() {
-    SpriteData* sd = (SpriteData*)texture;
-    if (sd->created) UnloadRenderTexture(sd->texture);
-    delete sd;
+    deleteSprite();
 }
 
 void* TFT_eSprite::createSprite(int16_t w, int16_t h) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (sd->created) UnloadRenderTexture(sd->texture);
-    
-    sd->texture = LoadRenderTexture(w, h);
-    sd->created = true;
+    deleteSprite();
     _w = w;
     _h = h;
-    return (void*)sd; // Return non-null to indicate success
+    if (_depth == 8) return _img8 = new uint8_t[w * h]();
+    return _img = new uint16_t[w * h]();
 }
 
 void TFT_eSprite::deleteSprite() {
-    SpriteData* sd = (SpriteData*)texture;
-    if (sd->created) {
-        UnloadRenderTexture(sd->texture);
-        sd->created = false;
-    }
+    delete[] _img;
+    delete[] _img8;
+    _img = nullptr;
+    _img8 = nullptr;
+    _w = 0;
+    _h = 0;
 }
 
 void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    
-    // Raylib's textures are upside down compared to what we expect usually if not handled
-    // But LoadRenderTexture creates standard GL texture.
-    // We draw it to the screen.
-    DrawTextureRec(sd->texture.texture, (Rectangle){0, 0, (float)sd->texture.texture.width, (float)-sd->texture.texture.height}, (Vector2){(float)x, (float)y}, WHITE);
+    if (!_img) return;
+    uint16_t* fb = _tft->frameBuffer();
+    int dw = _tft->width(), dh = _tft->height();
+    for (int sy = 0; sy < _h; sy++) {
+        int dy = y + sy;
+        if (dy < 0 || dy >= dh) continue;
+        for (int sx = 0; sx < _w; sx++) {
+            int dx = x + sx;
+            if (dx < 0 || dx >= dw) continue;
+            fb[dy * dw + dx] = swap16(_img[sy * _w + sx]);
+        }
+    }
 }
 
 void TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y) {
-   SpriteData* sd = (SpriteData*)texture;
-   SpriteData* target = (SpriteData*)dspr->texture;
-   
-   if (!sd->created || !target->created) return;
-   
-   BeginTextureMode(target->texture);
-   DrawTextureRec(sd->texture.texture, (Rectangle){0, 0, (float)sd->texture.texture.width, (float)-sd->texture.texture.height}, (Vector2){(float)x, (float)y}, WHITE);
-   EndTextureMode();
+    if (!_img || !dspr->_img) return;
+    for (int sy = 0; sy < _h; sy++) {
+        int dy = y + sy;
+        if (dy < 0 || dy >= dspr->_h) continue;
+        int sx0 = max(0, -x), sx1 = min((int)_w, dspr->_w - x);
+        if (sx1 <= sx0) continue;
+        memcpy(&dspr->_img[dy * dspr->_w + x + sx0], &_img[sy * _w + sx0],
+               (sx1 - sx0) * sizeof(uint16_t));
+    }
 }
 
-void TFT_eSprite::setColorDepth(int8_t b) {}
+void TFT_eSprite::pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, uint16_t transparent) {
+    if (!_img || !dspr->_img) return;
+    uint16_t key = swap16(transparent);
+    for (int sy = 0; sy < _h; sy++) {
+        int dy = y + sy;
+        if (dy < 0 || dy >= dspr->_h) continue;
+        int sx0 = max(0, -x), sx1 = min((int)_w, dspr->_w - x);
+        const uint16_t* src = &_img[sy * _w];
+        uint16_t* dst = &dspr->_img[dy * dspr->_w + x];
+        for (int sx = sx0; sx < sx1; sx++) {
+            if (src[sx] != key) dst[sx] = src[sx];
+        }
+    }
+}
+
+void TFT_eSprite::setColorDepth(int8_t b) { _depth = (b == 8) ? 8 : 16; }
 void TFT_eSprite::setAttribute(uint8_t id, uint8_t a) {}
 
-// Drawing primitives
+// Drawing primitives (same scan conversion as TFT_eSPI so both targets match)
 
 void TFT_eSprite::fillSprite(uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    ClearBackground(r565(color));
-    EndTextureMode();
+    if (_img8) { memset(_img8, color16to8(color), _w * _h); return; }
+    if (!_img) return;
+    uint16_t c = swap16(color);
+    for (int i = 0; i < _w * _h; i++) _img[i] = c;
 }
 
 void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawRectangle(x, y, w, h, r565(color));
-    EndTextureMode();
+    if (!created()) return;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > _w) w = _w - x;
+    if (y + h > _h) h = _h - y;
+    if (w < 1 || h < 1) return;
+    if (_img8) {
+        for (int yy = y; yy < y + h; yy++) memset(&_img8[yy * _w + x], color16to8(color), w);
+        return;
+    }
+    uint16_t c = swap16(color);
+    for (int yy = y; yy < y + h; yy++) {
+        uint16_t* row = &_img[yy * _w + x];
+        for (int i = 0; i < w; i++) row[i] = c;
+    }
 }
 
 void TFT_eSprite::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawRectangleLines(x, y, w, h, r565(color));
-    EndTextureMode();
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    // Avoid drawing corner pixels twice
+    drawFastVLine(x, y + 1, h - 2, color);
+    drawFastVLine(x + w - 1, y + 1, h - 2, color);
 }
 
 void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawLine(x, y, x + w, y, r565(color));
-    EndTextureMode();
+    fillRect(x, y, w, 1, color);
 }
 
-void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawLine(x0, y0, x1, y1, r565(color));
-    EndTextureMode();
-}
-
-void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawPixel(x, y, r565(color));
-    EndTextureMode();
+void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
 }
 
-void TFT_eSprite::fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    // Draw twice to handle both winding orders (Raylib culls CW by default in some versions/contexts)
-    DrawTriangle((Vector2){(float)x0, (float)y0}, (Vector2){(float)x1, (float)y1}, (Vector2){(float)x2, (float)y2}, r565(color));
-    DrawTriangle((Vector2){(float)x0, (float)y0}, (Vector2){(float)x2, (float)y2}, (Vector2){(float)x1, (float)y1}, r565(color));
-    EndTextureMode();
+void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) { swapVal(x0, y0); swapVal(x1, y1); }
+    if (x0 > x1) { swapVal(x0, x1); swapVal(y0, y1); }
+
+    int32_t dx = x1 - x0, dy = abs(y1 - y0);
+    int32_t err = dx >> 1, ystep = (y0 < y1) ? 1 : -1, xs = x0, dlen = 0;
+
+    // Emit runs as fast H/V lines, like TFT_eSPI::drawLine
+    for (; x0 <= x1; x0++) {
+        dlen++;
+        err -= dy;
+        if (err < 0) {
+            if (steep) drawFastVLine(y0, xs, dlen, color);
+            else       drawFastHLine(xs, y0, dlen, color);
+            dlen = 0;
+            y0 += ystep;
+            xs = x0 + 1;
+            err += dx;
+        }
+    }
+    if (dlen) {
+        if (steep) drawFastVLine(y0, xs, dlen, color);
+        else       drawFastHLine(xs, y0, dlen, color);
+    }
 }
 
-void TFT_eSprite::fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawCircle(x, y, r, r565(color));
-    EndTextureMode();
+void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint16_t color) {
+    if (!created() || x < 0 || y < 0 || x >= _w || y >= _h) return;
+    if (_img8) _img8[y * _w + x] = color16to8(color);
+    else       _img[y * _w + x] = swap16(color);
 }
 
-void TFT_eSprite::drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawCircleLines(x, y, r, r565(color));
-    EndTextureMode();
+uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y) {
+    if (!created() || x < 0 || y < 0 || x >= _w || y >= _h) return 0;
+    if (_img8) return color8to16(_img8[y * _w + x]);
+    return swap16(_img[y * _w + x]);
 }
 
-void TFT_eSprite::fillEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint16_t color) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawEllipse(x, y, rx, ry, r565(color));
-    EndTextureMode();
-}
+void TFT_eSprite::fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color) {
+    int32_t a, b, y, last;
+
+    // Sort coordinates by Y order (y2 >= y1 >= y0)
+    if (y0 > y1) { swapVal(y0, y1); swapVal(x0, x1); }
+    if (y1 > y2) { swapVal(y2, y1); swapVal(x2, x1); }
+    if (y0 > y1) { swapVal(y0, y1); swapVal(x0, x1); }
+
+    if (y0 == y2) { // All on the same line
+        a = b = x0;
+        if (x1 < a) a = x1; else if (x1 > b) b = x1;
+        if (x2 < a) a = x2; else if (x2 > b) b = x2;
+        drawFastHLine(a, y0, b - a + 1, color);
+        return;
+    }
 
-void TFT_eSprite::setTextColor(uint16_t color) {
-    text_color = color;
-}
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+            dx12 = x2 - x1, dy12 = y2 - y1, sa = 0, sb = 0;
 
-void TFT_eSprite::setTextColor(uint16_t fg, uint16_t bg) {
-    text_color = fg;
-    text_bgcolor = bg;
-}
+    last = (y1 == y2) ? y1 : y1 - 1; // Include y1 scanline only for flat bottoms
 
-void TFT_eSprite::setTextSize(uint8_t size) {
-    text_size = size;
-}
+    for (y = y0; y <= last; y++) {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) swapVal(a, b);
+        drawFastHLine(a, y, b - a + 1, color);
+    }
 
-void TFT_eSprite::setCursor(int16_t x, int16_t y) {
-    cursor_x = x;
-    cursor_y = y;
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) swapVal(a, b);
+        drawFastHLine(a, y, b - a + 1, color);
+    }
 }
 
-void TFT_eSprite::print(const char* str) {
-    SpriteData* sd = (SpriteData*)texture;
-    if (!sd->created) return;
-    BeginTextureMode(sd->texture);
-    DrawText(str, cursor_x, cursor_y, text_size * 10, r565(text_color)); // Simple scaling
-    EndTextureMode();
-    // Update cursor? (Simulated)
-    cursor_x += MeasureText(str, text_size * 10);
+void TFT_eSprite::fillCircle(int32_t x0, int32_t y0, int32_t r, uint16_t color) {
+    int32_t x = 0, dx = 1, dy = r + r, p = -(r >> 1);
+
+    drawFastHLine(x0 - r, y0, dy + 1, color);
+    while (x < r) {
+        if (p >= 0) {
+            drawFastHLine(x0 - x, y0 + r, dx, color);
+            drawFastHLine(x0 - x, y0 - r, dx, color);
+            dy -= 2;
+            p -= dy;
+            r--;
+        }
+        dx += 2;
+        p += dx;
+        x++;
+        drawFastHLine(x0 - r, y0 + x, dy + 1, color);
+        drawFastHLine(x0 - r, y0 - x, dy + 1, color);
+    }
 }
 
-void TFT_eSprite::print(String str) {
-    print(str.c_str());
+void TFT_eSprite::drawCircle(int32_t x0, int32_t y0, int32_t r, uint16_t color) {
+    int32_t x = 1, dx = 1, dy = r + r, p = -(r >> 1);
+
+    drawPixel(x0 + r, y0, color);
+    drawPixel(x0 - r, y0, color);
+    drawPixel(x0, y0 - r, color);
+    drawPixel(x0, y0 + r, color);
+
+    while (x < r) {
+        if (p >= 0) {
+            dy -= 2;
+            p -= dy;
+            r--;
+        }
+        dx += 2;
+        p += dx;
+        drawPixel(x0 + x, y0 + r, color);
+        drawPixel(x0 - x, y0 + r, color);
+        drawPixel(x0 - x, y0 - r, color);
+        drawPixel(x0 + x, y0 - r, color);
+        if (r != x) {
+            drawPixel(x0 + r, y0 + x, color);
+            drawPixel(x0 - r, y0 + x, color);
+            drawPixel(x0 - r, y0 - x, color);
+            drawPixel(x0 + r, y0 - x, color);
+        }
+        x++;
+    }
 }
 
-void TFT_eSprite::print(int n) {
-    print(std::to_string(n).c_str());
-}
+void TFT_eSprite::fillEllipse(int32_t x0, int32_t y0, int32_t rx, int32_t ry, uint16_t color) {
+    if (rx < 2 || ry < 2) return;
+    int32_t x, y, s;
+    int32_t rx2 = rx * rx, ry2 = ry * ry;
+    int32_t fx2 = 4 * rx2, fy2 = 4 * ry2;
+
+    for (x = 0, y = ry, s = 2 * ry2 + rx2 * (1 - 2 * ry); ry2 * x <= rx2 * y; x++) {
+        drawFastHLine(x0 - x, y0 - y, x + x + 1, color);
+        drawFastHLine(x0 - x, y0 + y, x + x + 1, color);
+        if (s >= 0) {
+            s += fx2 * (1 - y);
+            y--;
+        }
+        s += ry2 * ((4 * x) + 6);
+    }
 
-void TFT_eSprite::print(float n) {
-    char p[16];
-    sprintf(p, "%.2f", n);
-    print(p);
+    for (x = rx, y = 0, s = 2 * rx2 + ry2 * (1 - 2 * rx); rx2 * y <= ry2 * x; y++) {
+        drawFastHLine(x0 - x, y0 - y, x + x + 1, color);
+        drawFastHLine(x0 - x, y0 + y, x + x + 1, color);
+        if (s >= 0) {
+            s += fy2 * (1 - x);
+            x--;
+        }
+        s += rx2 * ((4 * y) + 6);
+    }
 }
@@ -29,6 +29,7 @@
 // PSRAM fake constant
 #define PSRAM_ENABLE 1
 
+// The "panel": a 320x240 RGB565 frame that main.cpp uploads to the window
 class TFT_eSPI {
 public:
     TFT_eSPI(int w = 320, int h = 240);
@@ -36,8 +37,32 @@ public:
     void setRotation(uint8_t r);
     void fillScreen(uint16_t color);
     uint16_t color565(uint8_t r, uint8_t g, uint8_t b); // Helper if needed
+
+    // Raw pixel upload. With swapBytes off (the default, and what
+    // pushSprite uses) data is in sprite byte order, i.e. byte-swapped.
+    void startWrite() {}
+    void endWrite() {}
+    void setSwapBytes(bool swap) { _swapBytes = swap; }
+    bool getSwapBytes() { return _swapBytes; }
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+
+    int16_t width()  { return _w; }
+    int16_t height() { return _h; }
+
+    // Display memory (native-endian RGB565), read by the window each frame
+    uint16_t* frameBuffer() { return _fb; }
+
+private:
+    int16_t _w, _h;
+    uint16_t* _fb;
+    bool _swapBytes = false;
 };
 
+// Software sprite with the same memory layout as the real TFT_eSprite at
+// 16 bpp: a w*h uint16_t buffer with each pixel stored byte-swapped.
+// setColorDepth(8) before createSprite gives a w*h byte buffer that the
+// drawing calls fill with the RGB332 reduction of the colour, as
+// TFT_eSprite does (push calls are 16 bpp only).
 class TFT_eSprite {
 public:
     TFT_eSprite(TFT_eSPI *tft);
@@ -45,44 +70,40 @@ public:
 
     void* createSprite(int16_t w, int16_t h);
     void deleteSprite();
-    
+    bool created() { return _img != nullptr || _img8 != nullptr; }
+
+    void* getPointer() { return _img ? (void*)_img : (void*)_img8; }
+    int16_t width()  { return _w; }
+    int16_t height() { return _h; }
+
     void pushSprite(int32_t x, int32_t y);
     void pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y);
-    
+    void pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, uint16_t transparent);
+
     void fillSprite(uint16_t color);
     void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
     void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
     void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color);
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color);
     void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color);
     void drawPixel(int32_t x, int32_t y, uint16_t color);
-    
+    uint16_t readPixel(int32_t x, int32_t y);
+
     void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color);
     void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color);
     void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color);
     void fillEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint16_t color);
-    
-    void setTextColor(uint16_t color);
-    void setTextColor(uint16_t fg, uint16_t bg);
-    void setTextSize(uint8_t size);
-    void setCursor(int16_t x, int16_t y);
-    
-    void print(const char* str);
-    void print(String str);
-    void print(int n);
-    void print(float n);
 
     void setColorDepth(int8_t b);
+    int8_t getColorDepth() { return _depth; }
     void setAttribute(uint8_t id, uint8_t a);
 
-    // Internal usage for Raylib integration
-    void* getTexture(); 
-
 private:
-   void* texture; // Raylib RenderTexture2D*
+   TFT_eSPI* _tft;
+   uint16_t* _img;  // Byte-swapped RGB565, like TFT_eSprite's 16-bit buffer
+   uint8_t* _img8;  // RGB332 buffer at 8 bpp
+   int8_t _depth = 16;
    int16_t _w, _h;
-   int16_t cursor_x, cursor_y;
-   uint16_t text_color, text_bgcolor;
-   uint8_t text_size;
 };
 
 #endif
@@ -0,0 +1,339 @@
+// Golden-image regression harness: renders fixed scenes (track seed, camera
+// and car state are all constants) into the same software sprite the game
+// uses, compares each frame against a stored PNG and times the scene.
+//
+//   golden [--update] [--dir golden] [--out golden_out] [--tol N]
+//          [--max-diff N] [--reps N] [--threads N] [scene ...]
+//
+// --update records the current output as the new goldens (do this before
+// starting an optimization, then run without it to check the result).
+// --threads N draws the world through the display list with N raster
+// threads (0, the default, draws immediately); the output must match the
+// same goldens, and the timings show how the frame scales with N.
+// Built with DRAW_STATS=1 (golden_stats.exe) each scene is followed by
+// its draw calls by kind and pixels per render stage (drawstats.h).
+// Failing scenes write <out>/<scene>.png and <out>/<scene>_diff.png.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "png.h"
+#include "TFT_eSPI.h"
+#include "../config.h"
+#include "../colors.h"
+#include "../physics.h"
+#include "../rendering.h"
+#include "../render_building.h"
+#include "../render_text.h"
+#include "../billboard.h"
+#include "../track.h"
+#include "../displist.h"
+#include "../arena.h"
+#include "../drawstats.h"
+
+#define GOLDEN_SEED  20240601u    // Track/traffic seed of every scene
+
+// ═══════════════════════════════════════════════════════════════
+//  SCENES
+// ═══════════════════════════════════════════════════════════════
+
+static int segCurve, segTunnel, segCity;  // Interesting places on the track
+
+// Fixed traffic ahead of the camera, spread over the lanes, so scenes
+// don't depend on where the simulation left the cars
+static void placeTraffic(int seg) {
+  static const float lanes[MAX_CARS] = { -0.6f, 0.6f, -0.2f, 0.25f, 0.8f, -0.8f };
+  for (int i = 0; i < MAX_CARS; i++) {
+    int s = (seg + 2 + 3 * i) % TOTAL_SEGS;
+    gameSim.traffic[i].z      = (int32_t)s << SEG_FX_SHIFT;
+    gameSim.traffic[i].offset = fxFromF(lanes[i]);
+    renderCarZ[i] = (float)s * SEG_LEN;
+  }
+}
+
+static void drawWorld(int seg, float playerXPos, int timeOfDay) {
+  initColors(timeOfDay);
+  renderPosition = seg * SEG_LEN + SEG_LEN * 0.25f;
+  renderPlayerX  = playerXPos;
+  placeTraffic(seg);
+  drawSky(renderPosition, playerZdist, timeOfDay, 0.0f);
+  drawRoad(renderPosition, renderPlayerX, playerZdist, cameraDepth, timeOfDay);
+}
+
+static void sceneSky()         { initColors(0); drawSky(0, playerZdist, 0, 120.0f); }
+static void sceneRoadDay()     { drawWorld(4, 0.0f, 0); }
+static void sceneRoadCurve()   { drawWorld(segCurve, -0.3f, 1); }
+static void sceneRoadTunnel()  { drawWorld(segTunnel, 0.2f, 2); }
+static void sceneRoadCity()    { drawWorld(segCity, 0.0f, 0); }
+
+static void scenePlayerCar() {
+  initColors(0);
+  spr.fillSprite(colRoadD);
+  renderPosition = 4 * SEG_LEN;
+  renderPlayerX  = 0.25f;
+  drawPlayerCar();
+}
+
+static void sceneTraffic() {
+  initColors(0);
+  spr.fillSprite(colGrassD);
+  drawTrafficCar(70,  200, 0.015f, TFT_RED,    SCR_H);
+  drawTrafficCar(170, 170, 0.008f, TFT_YELLOW, SCR_H);
+  drawTrafficCar(250, 150, 0.004f, TFT_CYAN,   SCR_H);
+}
+
+// Road point on a flat straight street, z segments ahead of the camera
+static RenderPt streetPt(float z) {
+  float sc = cameraDepth / (z * SEG_LEN);
+  RenderPt p = { (int16_t)SCR_CX, (int16_t)(SCR_CY + (int)(sc * CAM_HEIGHT * SCR_CY)),
+                 (int16_t)(sc * ROAD_W * SCR_CX), sc };
+  return p;
+}
+
+static void sceneBuildings() {
+  initColors(0);
+  spr.fillSprite(colSky3);
+  // One building per window style, left/right pairs, farthest first
+  for (int style = 5; style >= 0; style--) {
+    float z = 14.0f + (style / 2) * 6.0f;
+    RenderPt p0 = streetPt(z), p1 = streetPt(z + 3.0f);
+    Building b = { 150000 + style * 30000, rgb(60 + style * 15, 70, 110), (uint8_t)style, true };
+    drawBuilding(p0, p1, b, style, (style & 1) == 0);
+  }
+}
+
+static void sceneHUD() {
+  initColors(0);
+  spr.fillSprite(colRoadL);
+  currentLap = 2;
+  drawHUD(maxSpeed * 0.62f, maxSpeed, 42.37f, 38.5f);
+}
+
+static void sceneStartScreen() { drawStartScreen(1.25f); }
+
+static void sceneCrash() {
+  drawWorld(4, 0.0f, 0);
+  beginOverlay();
+  drawCrashMessage();
+}
+
+static void sceneFullFrame() {
+  drawWorld(segCurve, 0.1f, 0);
+  beginOverlay();
+  renderPosition = segCurve * SEG_LEN + SEG_LEN * 0.25f;
+  drawPlayerCar();
+  currentLap = 1;
+  drawHUD(maxSpeed * 0.8f, maxSpeed, 12.34f, 0);
+}
+
+struct Scene {
+  const char* name;
+  void (*draw)();
+};
+
+static const Scene scenes[] = {
+  { "sky",          sceneSky },
+  { "road_day",     sceneRoadDay },
+  { "road_curve",   sceneRoadCurve },
+  { "road_tunnel",  sceneRoadTunnel },
+  { "road_city",    sceneRoadCity },
+  { "player_car",   scenePlayerCar },
+  { "traffic",      sceneTraffic },
+  { "buildings",    sceneBuildings },
+  { "hud",          sceneHUD },
+  { "start_screen", sceneStartScreen },
+  { "crash",        sceneCrash },
+  { "full_frame",   sceneFullFrame },
+};
+static const int SCENE_COUNT = sizeof(scenes) / sizeof(scenes[0]);
+
+static void findTrackPlaces() {
+  segCurve = segTunnel = segCity = 4;
+  for (int i = 8; i < TOTAL_SEGS; i++) {
+    if (fabsf(segments[i].curve) > 4.0f) { segCurve = i - 6; break; }
+  }
+  for (int i = 0; i < TOTAL_SEGS; i++) {
+    if (segments[i].tunnel) { segTunnel = i + 6; break; }
+  }
+  for (int i = 0; i < TOTAL_SEGS; i++) {
+    if (buildingAt(segments, sceneSeed, i, true).height > 0 && buildingAt(segments, sceneSeed, i, false).height > 0) {
+      segCity = (i + TOTAL_SEGS - 4) % TOTAL_SEGS;
+      break;
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  CAPTURE AND COMPARE
+// ═══════════════════════════════════════════════════════════════
+
+// spr holds byte-swapped RGB565; expand to 8-bit RGB like a display would
+static void captureRGB(std::vector<uint8_t>& rgb) {
+  const uint16_t* fb = (const uint16_t*)spr.getPointer();
+  int n = spr.width() * spr.height();
+  rgb.resize((size_t)n * 3);
+  for (int i = 0; i < n; i++) {
+    uint16_t c = (uint16_t)((fb[i] >> 8) | (fb[i] << 8));
+    uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    rgb[i * 3 + 0] = (r << 3) | (r >> 2);
+    rgb[i * 3 + 1] = (g << 2) | (g >> 4);
+    rgb[i * 3 + 2] = (b << 3) | (b >> 2);
+  }
+}
+
+struct CompareResult {
+  int diffPixels;
+  int maxDelta;
+};
+
+// Pixels whose largest channel difference exceeds tol; diff image shows
+// them in red over a dimmed copy of the golden
+static CompareResult compare(const std::vector<uint8_t>& gold, const std::vector<uint8_t>& cur,
+                             int tol, std::vector<uint8_t>& diff) {
+  CompareResult r = { 0, 0 };
+  diff.resize(gold.size());
+  for (size_t i = 0; i < gold.size(); i += 3) {
+    int d = 0;
+    for (int c = 0; c < 3; c++) d = max(d, abs((int)gold[i + c] - (int)cur[i + c]));
+    r.maxDelta = max(r.maxDelta, d);
+    if (d > tol) {
+      r.diffPixels++;
+      diff[i] = (uint8_t)min(255, 128 + d);
+      diff[i + 1] = diff[i + 2] = 0;
+    } else {
+      uint8_t y = (uint8_t)((gold[i] * 77 + gold[i + 1] * 150 + gold[i + 2] * 29) >> 10);
+      diff[i] = diff[i + 1] = diff[i + 2] = y;
+    }
+  }
+  return r;
+}
+
+static uint32_t argValue(int& i, int argc, char** argv) {
+  if (i + 1 >= argc) {
+    fprintf(stderr, "missing value for %s\n", argv[i]);
+    exit(2);
+  }
+  return (uint32_t)strtoul(argv[++i], nullptr, 0);
+}
+
+int main(int argc, char** argv) {
+  std::string dir = "golden", out = "golden_out";
+  bool update = false;
+  int tol = 0, maxDiff = 0, reps = 20, threads = 0;
+  std::vector<std::string> only;
+
+  for (int i = 1; i < argc; i++) {
+    if      (!strcmp(argv[i], "--update"))   update  = true;
+    else if (!strcmp(argv[i], "--dir"))      { if (++i < argc) dir = argv[i]; }
+    else if (!strcmp(argv[i], "--out"))      { if (++i < argc) out = argv[i]; }
+    else if (!strcmp(argv[i], "--tol"))      tol     = (int)argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--max-diff")) maxDiff = (int)argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--reps"))     reps    = (int)argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--threads"))  threads = (int)argValue(i, argc, argv);
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "usage: %s [--update] [--dir D] [--out D] [--tol N] [--max-diff N] [--reps N] [--threads N] [scene ...]\n", argv[0]);
+      return 2;
+    }
+    else only.push_back(argv[i]);
+  }
+  if (reps < 1) reps = 1;
+
+  // Same start-up as setup(), minus the display and the start screen delay
+  randomSeed(1);
+  spr.setColorDepth(16);
+  spr.createSprite(SCR_W, SCR_H);
+  initPhysics(GOLDEN_SEED);
+  initColors(0);
+  initText();
+  initHUD();
+  initBackground();
+  initBillboards();
+  initPlayerCar();
+  findTrackPlaces();
+  dlSetThreads((uint8_t)min(threads, 255));
+
+  std::filesystem::create_directories(dir);
+  int failed = 0, run = 0;
+  std::vector<uint8_t> cur, gold, diff;
+
+  if (threads) printf("display list, %d raster threads\n", dlThreads);
+  printf("%-14s %-8s %10s %6s %10s %10s %8s\n", "scene", "result", "diff px", "max", "avg us", "min us", "fps");
+  for (int s = 0; s < SCENE_COUNT; s++) {
+    const Scene& sc = scenes[s];
+    if (!only.empty() && std::find(only.begin(), only.end(), sc.name) == only.end()) continue;
+    run++;
+
+    // First render is the one checked; the rest are timed. Scenes are
+    // always run in the same order so stateful renderers (car pitch
+    // smoothing, HUD caches) start from the same state every run.
+    spr.fillSprite(TFT_BLACK);
+    frameReset();
+    dsFrameEnd();
+    sc.draw();
+    dlFlush();
+    dsFrameEnd();
+    captureRGB(cur);
+
+    double total = 0, best = 1e30;
+    for (int r = 0; r < reps; r++) {
+      auto t0 = std::chrono::steady_clock::now();
+      frameReset();
+      sc.draw();
+      dlFlush();
+      double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+      total += us;
+      best = min(best, us);
+    }
+
+    std::string goldPath = dir + "/" + sc.name + ".png";
+    const char* result;
+    CompareResult cr = { 0, 0 };
+    int gw, gh;
+
+    if (update) {
+      result = pngWrite(goldPath.c_str(), SCR_W, SCR_H, cur.data()) ? "updated" : "IO-ERR";
+    } else if (!pngRead(goldPath.c_str(), gw, gh, gold)) {
+      result = "MISSING";
+      failed++;
+    } else if (gw != SCR_W || gh != SCR_H) {
+      result = "SIZE";
+      failed++;
+    } else {
+      cr = compare(gold, cur, tol, diff);
+      if (cr.diffPixels <= maxDiff) {
+        result = "ok";
+      } else {
+        result = "FAIL";
+        failed++;
+        std::filesystem::create_directories(out);
+        pngWrite((out + "/" + sc.name + ".png").c_str(), SCR_W, SCR_H, cur.data());
+        pngWrite((out + "/" + sc.name + "_diff.png").c_str(), SCR_W, SCR_H, diff.data());
+      }
+    }
+
+    printf("%-14s %-8s %10d %6d %10.1f %10.1f %8.0f\n", sc.name, result, cr.diffPixels, cr.maxDelta,
+           total / reps, best, 1e6 * reps / total);
+#if DRAW_STATS
+    for (int i = 0; i < DS_STAGES; i++) {
+      const DrawCount& d = dsFrame((DrawStage)i);
+      if (!d.pixels && !d.calls[DP_RECT] && !d.calls[DP_TRI] && !d.calls[DP_PIXEL] && !d.calls[DP_OTHER]) continue;
+      printf("    %s  rect %6u  tri %6u  pixel %6u  other %5u  pixels %7u\n", dsStageNames[i],
+             d.calls[DP_RECT], d.calls[DP_TRI], d.calls[DP_PIXEL], d.calls[DP_OTHER], d.pixels);
+    }
+#endif
+  }
+
+  if (run == 0) {
+    fprintf(stderr, "no matching scene\n");
+    return 2;
+  }
+  printf("frame arena peak: %u of %u bytes\n", (unsigned)frameArenaPeak(), (unsigned)FRAME_ARENA_BYTES);
+  if (failed) printf("%d of %d scenes failed (tolerance %d, max %d pixels)\n", failed, run, tol, maxDiff);
+  return failed ? 1 : 0;
+}
@@ -1,10 +1,16 @@
 #include "raylib.h"
 #include "Arduino.h"
 #include "TFT_eSPI.h"
+#include "../config.h"
+#include "../profiler.h"
+#include "../gfx.h"
+#include "../displist.h"
+#include "../input.h"
 
 // Externs from the game
 extern void setup();
 extern void loop();
+extern TFT_eSPI tft;
 
 int main() {
     // 1. Initialize Window
@@ -14,21 +20,37 @@ int main() {
     // 2. Setup (Game Logic)
     setup();
 
+    // The game renders into software sprites and pushes them to the TFT
+    // frame buffer; the window just shows that buffer as a texture.
+    Image frame = { tft.frameBuffer(), tft.width(), tft.height(), 1, PIXELFORMAT_UNCOMPRESSED_R5G6B5 };
+    Texture2D screen = LoadTextureFromImage(frame);
+
     // 3. Main Loop
     while (!WindowShouldClose()) {
+        // Buttons are active low (INPUT_PULLUP); input.cpp samples the
+        // pins from its own thread, as the ESP32's timer does
+        emuSetPin(BTN_LEFT,  IsKeyDown(KEY_LEFT)  ? LOW : HIGH);
+        emuSetPin(BTN_RIGHT, IsKeyDown(KEY_RIGHT) ? LOW : HIGH);
+        if (IsKeyPressed(KEY_F3)) profOverlay = !profOverlay;
+        if (IsKeyPressed(KEY_F4)) setWorldRes((worldRes + 1) % WORLD_RES_MODES);
+        if (IsKeyPressed(KEY_F5)) setWorldIndexed(!worldIndexed);
+        if (IsKeyPressed(KEY_F6)) dlSetThreads(dlThreads ? 0 : 4);
+        if (IsKeyPressed(KEY_F7)) inputLatencyReport();
+
+        loop(); // drawSky, drawRoad, ... -> spr.pushSprite -> tft frame buffer
+
+        UpdateTexture(screen, tft.frameBuffer());
+
         BeginDrawing();
-        // ClearBackground(BLACK); // loop calls this via TFT calls usually, or we do it here?
-        // The game loop calls spr.pushSprite(0,0) which draws to screen.
-        // calls to spr.fillSprite/etc will draw to texture.
-        
-        loop(); // This calls drawSky, drawRoad -> spr.pushSprite -> DrawTextureRec
-        
+        DrawTexture(screen, 0, 0, WHITE);
+
         // Debug info
         DrawFPS(10, 10);
-        
+
         EndDrawing();
     }
 
+    UnloadTexture(screen);
     CloseWindow();
     return 0;
 }
@@ -0,0 +1,137 @@
+#include "png.h"
+#include <stdio.h>
+#include <string.h>
+
+static const uint8_t PNG_SIG[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+static uint32_t crcTable[256];
+
+static void initCrc() {
+    if (crcTable[1]) return;
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crcTable[n] = c;
+    }
+}
+
+static uint32_t crc32(uint32_t crc, const uint8_t* p, size_t n) {
+    crc = ~crc;
+    while (n--) crc = crcTable[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void put32(std::vector<uint8_t>& v, uint32_t x) {
+    v.push_back(x >> 24); v.push_back(x >> 16); v.push_back(x >> 8); v.push_back(x);
+}
+
+static uint32_t get32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void writeChunk(FILE* f, const char* type, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> buf;
+    put32(buf, (uint32_t)data.size());
+    buf.insert(buf.end(), type, type + 4);
+    buf.insert(buf.end(), data.begin(), data.end());
+    std::vector<uint8_t> crc;
+    put32(crc, crc32(0, buf.data() + 4, buf.size() - 4));
+    fwrite(buf.data(), 1, buf.size(), f);
+    fwrite(crc.data(), 1, 4, f);
+}
+
+bool pngWrite(const char* path, int w, int h, const uint8_t* rgb) {
+    initCrc();
+
+    // Raw scanlines, each prefixed with filter type 0
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)(w * 3 + 1) * h);
+    for (int y = 0; y < h; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb + (size_t)y * w * 3, rgb + (size_t)(y + 1) * w * 3);
+    }
+
+    // zlib stream of stored blocks
+    std::vector<uint8_t> z = { 0x78, 0x01 };
+    size_t pos = 0;
+    do {
+        size_t n = raw.size() - pos;
+        if (n > 65535) n = 65535;
+        z.push_back(pos + n == raw.size() ? 1 : 0);  // BFINAL, BTYPE = 00
+        z.push_back(n & 0xFF); z.push_back(n >> 8);
+        z.push_back(~n & 0xFF); z.push_back((~n >> 8) & 0xFF);
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+    } while (pos < raw.size());
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t c : raw) { a = (a + c) % 65521; b = (b + a) % 65521; }
+    put32(z, (b << 16) | a);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fwrite(PNG_SIG, 1, 8, f);
+
+    std::vector<uint8_t> ihdr;
+    put32(ihdr, w);
+    put32(ihdr, h);
+    ihdr.insert(ihdr.end(), { 8, 2, 0, 0, 0 });  // 8-bit RGB, no interlace
+    writeChunk(f, "IHDR", ihdr);
+    writeChunk(f, "IDAT", z);
+    writeChunk(f, "IEND", {});
+    return fclose(f) == 0;
+}
+
+bool pngRead(const char* path, int& w, int& h, std::vector<uint8_t>& rgb) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    std::vector<uint8_t> file;
+    uint8_t tmp[65536];
+    size_t n;
+    while ((n = fread(tmp, 1, sizeof(tmp), f)) > 0) file.insert(file.end(), tmp, tmp + n);
+    fclose(f);
+
+    if (file.size() < 8 || memcmp(file.data(), PNG_SIG, 8) != 0) return false;
+
+    std::vector<uint8_t> z;
+    w = h = 0;
+    for (size_t p = 8; p + 12 <= file.size();) {
+        uint32_t len = get32(&file[p]);
+        if (p + 12 + len > file.size()) return false;
+        const uint8_t* type = &file[p + 4];
+        const uint8_t* data = &file[p + 8];
+        if (!memcmp(type, "IHDR", 4)) {
+            w = (int)get32(data);
+            h = (int)get32(data + 4);
+            if (data[8] != 8 || data[9] != 2 || data[12] != 0) return false;
+        } else if (!memcmp(type, "IDAT", 4)) {
+            z.insert(z.end(), data, data + len);
+        } else if (!memcmp(type, "IEND", 4)) {
+            break;
+        }
+        p += 12 + len;
+    }
+    if (w <= 0 || h <= 0 || z.size() < 2) return false;
+
+    // Stored deflate blocks only
+    std::vector<uint8_t> raw;
+    size_t p = 2;
+    for (bool last = false; !last;) {
+        if (p + 5 > z.size() || (z[p] & 0x06) != 0) return false;
+        last = z[p] & 1;
+        size_t len = z[p + 1] | (z[p + 2] << 8);
+        p += 5;
+        if (p + len > z.size()) return false;
+        raw.insert(raw.end(), z.begin() + p, z.begin() + p + len);
+        p += len;
+    }
+
+    size_t stride = (size_t)w * 3;
+    if (raw.size() != (stride + 1) * h) return false;
+    rgb.resize(stride * h);
+    for (int y = 0; y < h; y++) {
+        if (raw[y * (stride + 1)] != 0) return false;  // Row filter 0 only
+        memcpy(&rgb[y * stride], &raw[y * (stride + 1) + 1], stride);
+    }
+    return true;
+}
@@ -0,0 +1,19 @@
+#ifndef _EMU_PNG_H_
+#define _EMU_PNG_H_
+
+#include <stdint.h>
+#include <vector>
+
+// Minimal 8-bit RGB PNG I/O for the host tools. Files are written with
+// uncompressed (stored) deflate blocks and no row filters, and only files
+// in that form can be read back: enough for goldens this tool produced,
+// no zlib dependency.
+
+// rgb: w*h*3 bytes, row-major. Returns false on I/O error.
+bool pngWrite(const char* path, int w, int h, const uint8_t* rgb);
+
+// Fills w, h and rgb (w*h*3). Returns false if the file is missing or
+// not a PNG in the form pngWrite() produces.
+bool pngRead(const char* path, int& w, int& h, std::vector<uint8_t>& rgb);
+
+#endif
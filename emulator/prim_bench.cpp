@@ -0,0 +1,27 @@
+// Rasterization primitive micro-benchmark, host build. Runs the same
+// runPrimBench() the device runs with PRIM_BENCH = 1, on the software
+// sprite, so the numbers of both builds line up row by row.
+//
+//   prim_bench [primitive]
+//
+// primitive filters by name substring (e.g. "Quad", "Tri").
+
+#include <cstdio>
+
+#include "TFT_eSPI.h"
+#include "../config.h"
+#include "../colors.h"
+#include "../rendering.h"
+#include "../bench_prims.h"
+
+int main(int argc, char** argv) {
+  spr.setColorDepth(16);
+  if (spr.createSprite(SCR_W, SCR_H) == nullptr) {
+    fprintf(stderr, "failed to create sprite\n");
+    return 1;
+  }
+  initColors(0);
+
+  runPrimBench(argc > 1 ? argv[1] : nullptr);
+  return 0;
+}
@@ -0,0 +1,134 @@
+// Headless batch runner: simulates many seeds in parallel with the same
+// SimContext code the game runs, without drawing, and prints lap-time and
+// crash statistics. Used to tune config.h physics and the autopilot.
+//
+//   sim_batch [--seeds N] [--first S] [--laps L] [--threads T] [--csv]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../sim.h"
+
+struct SeedResult {
+  uint32_t seed;
+  uint32_t laps;
+  int32_t  bestLapTicks;
+  uint64_t lapTicksSum;     // Sum of completed lap times
+  uint32_t crashes;
+  uint32_t ticks;
+  bool     finished;
+};
+
+static void runSeed(SimContext& ctx, uint32_t seed, uint32_t laps, SeedResult& r) {
+  const SimInput input = { true, 0, 0 };
+  // Give up if the car is stuck (e.g. stalled on a hill): 60 s per lap
+  const uint32_t maxTicks = laps * 60u * SIM_HZ;
+
+  simInit(ctx, seed);
+  r.seed = seed;
+  r.lapTicksSum = 0;
+
+  uint32_t seen = 0;
+  while (ctx.lapsDone < laps && ctx.ticks < maxTicks) {
+    simTick(ctx, input);
+    if (ctx.lapsDone != seen) {
+      seen = ctx.lapsDone;
+      r.lapTicksSum += ctx.lastLapTicks;
+    }
+  }
+
+  r.laps         = ctx.lapsDone;
+  r.bestLapTicks = ctx.bestLapTicks;
+  r.crashes      = ctx.crashes;
+  r.ticks        = ctx.ticks;
+  r.finished     = ctx.lapsDone >= laps;
+}
+
+static uint32_t argValue(int& i, int argc, char** argv) {
+  if (i + 1 >= argc) {
+    fprintf(stderr, "missing value for %s\n", argv[i]);
+    exit(2);
+  }
+  return (uint32_t)strtoul(argv[++i], nullptr, 0);
+}
+
+int main(int argc, char** argv) {
+  uint32_t seeds   = 1000;
+  uint32_t first   = 1;
+  uint32_t laps    = 10;
+  uint32_t threads = std::thread::hardware_concurrency();
+  bool csv = false;
+
+  for (int i = 1; i < argc; i++) {
+    if      (!strcmp(argv[i], "--seeds"))   seeds   = argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--first"))   first   = argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--laps"))    laps    = argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--threads")) threads = argValue(i, argc, argv);
+    else if (!strcmp(argv[i], "--csv"))     csv     = true;
+    else {
+      fprintf(stderr, "usage: %s [--seeds N] [--first S] [--laps L] [--threads T] [--csv]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (threads == 0) threads = 1;
+  if (seeds == 0 || laps == 0) return 0;
+
+  std::vector<SeedResult> results(seeds);
+  std::atomic<uint32_t> next(0);
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (uint32_t t = 0; t < threads; t++) {
+    pool.emplace_back([&]() {
+      SimContext ctx;  // One per thread, reused for each seed
+      for (uint32_t i; (i = next.fetch_add(1)) < seeds;)
+        runSeed(ctx, first + i, laps, results[i]);
+    });
+  }
+  for (auto& th : pool) th.join();
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  if (csv) printf("seed,laps,best_lap_s,avg_lap_s,crashes,finished\n");
+
+  uint64_t totalLaps = 0, totalTicks = 0, totalCrashes = 0;
+  uint32_t finished = 0;
+  double bestSum = 0;
+  const SeedResult* fastest = nullptr;
+  const SeedResult* slowest = nullptr;
+
+  for (const SeedResult& r : results) {
+    totalLaps    += r.laps;
+    totalTicks   += r.ticks;
+    totalCrashes += r.crashes;
+    if (csv) {
+      printf("%u,%u,%.3f,%.3f,%u,%d\n", r.seed, r.laps,
+             r.bestLapTicks / (double)SIM_HZ,
+             r.laps ? r.lapTicksSum / (double)r.laps / SIM_HZ : 0.0,
+             r.crashes, r.finished ? 1 : 0);
+    }
+    if (!r.finished) continue;
+    finished++;
+    bestSum += r.bestLapTicks;
+    if (!fastest || r.bestLapTicks < fastest->bestLapTicks) fastest = &r;
+    if (!slowest || r.bestLapTicks > slowest->bestLapTicks) slowest = &r;
+  }
+
+  FILE* out = csv ? stderr : stdout;
+  fprintf(out, "seeds %u..%u, %u laps each, %u threads\n", first, first + seeds - 1, laps, threads);
+  fprintf(out, "finished   %u/%u (%u stalled or too slow)\n", finished, seeds, seeds - finished);
+  if (finished) {
+    fprintf(out, "best lap   mean %.3f s, fastest %.3f s (seed %u), slowest %.3f s (seed %u)\n",
+            bestSum / finished / SIM_HZ,
+            fastest->bestLapTicks / (double)SIM_HZ, fastest->seed,
+            slowest->bestLapTicks / (double)SIM_HZ, slowest->seed);
+  }
+  fprintf(out, "crashes    %.2f per seed\n", (double)totalCrashes / seeds);
+  fprintf(out, "throughput %.0f laps/s, %.2f M ticks/s (%.1f s simulated in %.2f s)\n",
+          totalLaps / secs, totalTicks / secs / 1e6, totalTicks / (double)SIM_HZ, secs);
+  return 0;
+}
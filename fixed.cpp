@@ -0,0 +1,43 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FIXED-POINT MATH IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "fixed.h"
+#include <Arduino.h>
+
+// atan(i / 64) in Q16.16, i = 0..64
+static const int32_t PROGMEM atanTable[65] = {
+       0,   1024,   2047,   3070,   4091,   5110,   6126,   7140,
+    8150,   9156,  10158,  11155,  12147,  13133,  14114,  15088,
+   16055,  17015,  17968,  18913,  19850,  20779,  21699,  22610,
+   23512,  24406,  25289,  26163,  27028,  27882,  28727,  29561,
+   30386,  31200,  32003,  32797,  33580,  34353,  35115,  35867,
+   36608,  37340,  38060,  38771,  39472,  40162,  40842,  41512,
+   42172,  42823,  43464,  44095,  44716,  45328,  45931,  46525,
+   47109,  47685,  48251,  48809,  49359,  49899,  50432,  50956,
+   51472
+};
+
+fx_t fxAtan2(fx_t y, fx_t x) {
+  if (x == 0 && y == 0) return 0;
+
+  // Reduce to the first octant: ratio = min/max in [0, 1]
+  int64_t ax = (x < 0) ? -(int64_t)x : x;
+  int64_t ay = (y < 0) ? -(int64_t)y : y;
+  bool steep = ay > ax;
+  uint32_t ratio = (uint32_t)(((steep ? ax : ay) << FX_SHIFT) / (steep ? ay : ax));
+
+  int idx  = ratio >> 10;          // 64 table steps over [0, 1]
+  int frac = ratio & 1023;
+  int32_t a = (int32_t)pgm_read_dword(&atanTable[idx]);
+  if (idx < 64) {
+    int32_t b = (int32_t)pgm_read_dword(&atanTable[idx + 1]);
+    a += ((b - a) * frac) >> 10;
+  }
+
+  if (steep) a = FX_HALF_PI - a;
+  if (x < 0) a = FX_PI - a;
+  return (y < 0) ? -a : a;
+}
@@ -0,0 +1,43 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FIXED-POINT MATH (Q16.16)
+  Integer arithmetic for the simulation, so physics gives the same
+  results on the ESP32 and on the host
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+typedef int32_t fx_t;             // Q16.16
+
+#define FX_SHIFT     16
+#define FX_ONE       ((fx_t)1 << FX_SHIFT)
+#define FX_PI        ((fx_t)205887)
+#define FX_HALF_PI   ((fx_t)102944)
+
+// Compile-time conversion of a float constant (rounded to nearest)
+#define FX(f)        ((fx_t)((f) * 65536.0 + ((f) >= 0 ? 0.5 : -0.5)))
+
+// Runtime conversions
+static inline fx_t  fxFromF(float f) { return (fx_t)(f * 65536.0f + (f >= 0 ? 0.5f : -0.5f)); }
+static inline float fxToF(fx_t v)    { return v * (1.0f / FX_ONE); }
+
+static inline fx_t fxMul(fx_t a, fx_t b) {
+  return (fx_t)(((int64_t)a * b) >> FX_SHIFT);
+}
+
+static inline fx_t fxDiv(fx_t a, fx_t b) {
+  return (fx_t)(((int64_t)a << FX_SHIFT) / b);
+}
+
+static inline fx_t fxClamp(fx_t v, fx_t lo, fx_t hi) {
+  return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// atan2 from a 65-entry table with linear interpolation (error < 0.0001 rad)
+fx_t fxAtan2(fx_t y, fx_t x);
+
+#endif // FIXED_H
@@ -0,0 +1,756 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  WORLD DRAW TARGET IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include <initializer_list>
+
+#include "gfx.h"
+#include "config.h"
+#include "rendering.h"
+#include "colors.h"
+#include "displist.h"
+#include "arena.h"
+#include "memmap.h"
+#include "drawstats.h"
+
+TFT_eSprite worldSpr = TFT_eSprite(&tft);
+uint8_t worldRes = WORLD_RES_FULL;
+bool worldIndexed = false;
+
+static uint8_t shX = 0, shY = 0;   // Full-res -> world coordinate shifts
+
+// PRESENT_ROWS bands of spr that may hold something other than
+// OVERLAY_KEY, bit b = rows b * PRESENT_ROWS ... Unknown at first
+static uint32_t ovBands = ~0u;
+static_assert((SCR_H + PRESENT_ROWS - 1) / PRESENT_ROWS <= 32, "overlay bands must fit ovBands");
+
+// RGB565 at full resolution draws straight into spr; every other
+// combination gets its own worldSpr in internal SRAM (fast fills)
+static bool allocWorld(uint8_t res, bool indexed) {
+  if (res >= WORLD_RES_MODES) res = WORLD_RES_FULL;
+  dlFlush();
+  ovBands = ~0u;                    // spr may hold a full-resolution world
+  if (worldSpr.created()) worldSpr.deleteSprite();
+  memRegisterSprite("worldSpr", "gfx", worldSpr, MEM_SRAM, true);
+  worldRes = WORLD_RES_FULL;
+  worldIndexed = false;
+  shX = shY = 0;
+  if (res == WORLD_RES_FULL && !indexed) return true;
+
+  uint8_t sx = (res == WORLD_RES_HALF) ? 1 : 0;
+  uint8_t sy = (res == WORLD_RES_FULL) ? 0 : 1;
+  worldSpr.setColorDepth(indexed ? 8 : 16);
+  worldSpr.setAttribute(PSRAM_ENABLE, false);
+  if (worldSpr.createSprite(SCR_W >> sx, SCR_H >> sy) == nullptr) {
+    Serial.println("ERROR: Failed to create worldSpr, staying at full resolution");
+    return false;
+  }
+  memRegisterSprite("worldSpr", "gfx", worldSpr, MEM_SRAM, true);
+  worldRes = res;
+  worldIndexed = indexed;
+  shX = sx;
+  shY = sy;
+  return true;
+}
+
+bool setWorldRes(uint8_t res) {
+  return allocWorld(res, worldIndexed);
+}
+
+bool setWorldIndexed(bool on) {
+  return allocWorld(worldRes, on);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  BAND RASTERIZERS
+//  Every world primitive is a GfxCmd (displist.h) drawn by gfxExec
+//  into rows lo..hi of the layer only, so separate bands of a frame
+//  can be filled by separate threads. Immediately, a command is one
+//  band covering all of its rows. The scan conversion is TFT_eSPI's,
+//  so output matches the sprite calls this replaced
+// ═══════════════════════════════════════════════════════════════
+
+static inline bool direct() { return !worldSpr.created(); }
+
+static inline uint16_t swap16(uint16_t c) { return (uint16_t)((c >> 8) | (c << 8)); }
+
+static inline void swap32(int32_t& a, int32_t& b) { int32_t t = a; a = b; b = t; }
+
+static inline void fillPx(uint16_t* d, int32_t n, uint16_t c) { while (n-- > 0) *d++ = c; }
+static inline void fillPx(uint8_t* d, int32_t n, uint8_t c)   { memset(d, c, n); }
+
+template <typename T> struct Band {
+  T* buf;
+  int32_t w, lo, hi;        // Layer width; rows lo..hi may be written
+  mutable uint32_t px;      // Pixels written (DRAW_STATS)
+
+  void count(int32_t n) const { if (DRAW_STATS) px += n; }
+
+  void hline(int32_t x, int32_t y, int32_t n, T c) const {
+    if (y < lo || y > hi) return;
+    if (x < 0) { n += x; x = 0; }
+    if (x + n > w) n = w - x;
+    if (n <= 0) return;
+    fillPx(buf + y * w + x, n, c);
+    count(n);
+  }
+
+  void rect(int32_t x, int32_t y, int32_t rw, int32_t rh, T c) const {
+    int32_t y1 = min(y + rh - 1, hi);
+    for (int32_t r = max(y, lo); r <= y1; r++) hline(x, r, rw, c);
+  }
+
+  void pixel(int32_t x, int32_t y, T c) const {
+    if (y >= lo && y <= hi && x >= 0 && x < w) {
+      buf[y * w + x] = c;
+      count(1);
+    }
+  }
+};
+
+template <typename T>
+static void bandLine(const Band<T>& b, int32_t x0, int32_t y0, int32_t x1, int32_t y1, T c) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) { swap32(x0, y0); swap32(x1, y1); }
+  if (x0 > x1) { swap32(x0, x1); swap32(y0, y1); }
+
+  int32_t dx = x1 - x0, dy = abs(y1 - y0);
+  int32_t err = dx >> 1, ystep = (y0 < y1) ? 1 : -1, xs = x0, dlen = 0;
+
+  // Runs go out as horizontal or vertical lines
+  for (; x0 <= x1; x0++) {
+    dlen++;
+    err -= dy;
+    if (err < 0) {
+      if (steep) b.rect(y0, xs, 1, dlen, c);
+      else       b.hline(xs, y0, dlen, c);
+      dlen = 0;
+      y0 += ystep;
+      xs = x0 + 1;
+      err += dx;
+    }
+  }
+  if (dlen) {
+    if (steep) b.rect(y0, xs, 1, dlen, c);
+    else       b.hline(xs, y0, dlen, c);
+  }
+}
+
+// Edge positions are closed-form in y, so rows outside the band are
+// skipped rather than stepped through
+template <typename T>
+static void bandTriangle(const Band<T>& b, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                         int32_t x2, int32_t y2, int32_t clipY, T c) {
+  if (y0 > y1) { swap32(y0, y1); swap32(x0, x1); }
+  if (y1 > y2) { swap32(y2, y1); swap32(x2, x1); }
+  if (y0 > y1) { swap32(y0, y1); swap32(x0, x1); }
+
+  int32_t hi = min(b.hi, clipY - 1);
+  if (y0 == y2) {
+    if (y0 > hi) return;
+    int32_t a = min(x0, min(x1, x2)), e = max(x0, max(x1, x2));
+    b.hline(a, y0, e - a + 1, c);
+    return;
+  }
+
+  int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+          dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t last = (y1 == y2) ? y1 : y1 - 1;   // Include y1 only for flat bottoms
+
+  int32_t y = max(y0, b.lo), yEnd = min(last, hi);
+  int32_t sa = dx01 * (y - y0), sb = dx02 * (y - y0);
+  for (; y <= yEnd; y++, sa += dx01, sb += dx02) {
+    int32_t xa = x0 + sa / dy01, xb = x0 + sb / dy02;
+    if (xa > xb) swap32(xa, xb);
+    b.hline(xa, y, xb - xa + 1, c);
+  }
+
+  y = max(last + 1, b.lo);
+  yEnd = min(y2, hi);
+  sa = dx12 * (y - y1);
+  sb = dx02 * (y - y0);
+  for (; y <= yEnd; y++, sa += dx12, sb += dx02) {
+    int32_t xa = x1 + sa / dy12, xb = x0 + sb / dy02;
+    if (xa > xb) swap32(xa, xb);
+    b.hline(xa, y, xb - xa + 1, c);
+  }
+}
+
+template <typename T>
+static void bandCircle(const Band<T>& b, int32_t x0, int32_t y0, int32_t r, T c) {
+  int32_t x = 0, dx = 1, dy = r + r, p = -(r >> 1);
+
+  b.hline(x0 - r, y0, dy + 1, c);
+  while (x < r) {
+    if (p >= 0) {
+      b.hline(x0 - x, y0 + r, dx, c);
+      b.hline(x0 - x, y0 - r, dx, c);
+      dy -= 2;
+      p -= dy;
+      r--;
+    }
+    dx += 2;
+    p += dx;
+    x++;
+    b.hline(x0 - r, y0 + x, dy + 1, c);
+    b.hline(x0 - r, y0 - x, dy + 1, c);
+  }
+}
+
+template <typename T>
+static void bandRing(const Band<T>& b, int32_t x0, int32_t y0, int32_t r, T c) {
+  int32_t x = 1, dx = 1, dy = r + r, p = -(r >> 1);
+
+  b.pixel(x0 + r, y0, c);
+  b.pixel(x0 - r, y0, c);
+  b.pixel(x0, y0 - r, c);
+  b.pixel(x0, y0 + r, c);
+
+  while (x < r) {
+    if (p >= 0) {
+      dy -= 2;
+      p -= dy;
+      r--;
+    }
+    dx += 2;
+    p += dx;
+    b.pixel(x0 + x, y0 + r, c);
+    b.pixel(x0 - x, y0 + r, c);
+    b.pixel(x0 - x, y0 - r, c);
+    b.pixel(x0 + x, y0 - r, c);
+    if (r != x) {
+      b.pixel(x0 + r, y0 + x, c);
+      b.pixel(x0 - r, y0 + x, c);
+      b.pixel(x0 - r, y0 - x, c);
+      b.pixel(x0 + r, y0 - x, c);
+    }
+    x++;
+  }
+}
+
+// TFT_eSPI's drawEllipse, minus its rx, ry < 2 early out so small
+// rings squashed at 320x120 still show
+template <typename T>
+static void bandEllipseRing(const Band<T>& b, int32_t x0, int32_t y0, int32_t rx, int32_t ry, T c) {
+  int32_t x, y, s;
+  int32_t rx2 = rx * rx, ry2 = ry * ry;
+  int32_t fx2 = 4 * rx2, fy2 = 4 * ry2;
+
+  for (x = 0, y = ry, s = 2 * ry2 + rx2 * (1 - 2 * ry); ry2 * x <= rx2 * y; x++) {
+    b.pixel(x0 + x, y0 + y, c);
+    b.pixel(x0 - x, y0 + y, c);
+    b.pixel(x0 - x, y0 - y, c);
+    b.pixel(x0 + x, y0 - y, c);
+    if (s >= 0) {
+      s += fx2 * (1 - y);
+      y--;
+    }
+    s += ry2 * ((4 * x) + 6);
+  }
+
+  for (x = rx, y = 0, s = 2 * rx2 + ry2 * (1 - 2 * rx); rx2 * y <= ry2 * x; y++) {
+    b.pixel(x0 + x, y0 + y, c);
+    b.pixel(x0 - x, y0 + y, c);
+    b.pixel(x0 - x, y0 - y, c);
+    b.pixel(x0 + x, y0 - y, c);
+    if (s >= 0) {
+      s += fy2 * (1 - x);
+      x--;
+    }
+    s += rx2 * ((4 * y) + 6);
+  }
+}
+
+template <typename T>
+static void bandEllipse(const Band<T>& b, int32_t x0, int32_t y0, int32_t rx, int32_t ry, T c) {
+  if (rx < 2 || ry < 2) return;
+  int32_t x, y, s;
+  int32_t rx2 = rx * rx, ry2 = ry * ry;
+  int32_t fx2 = 4 * rx2, fy2 = 4 * ry2;
+
+  for (x = 0, y = ry, s = 2 * ry2 + rx2 * (1 - 2 * ry); ry2 * x <= rx2 * y; x++) {
+    b.hline(x0 - x, y0 - y, x + x + 1, c);
+    b.hline(x0 - x, y0 + y, x + x + 1, c);
+    if (s >= 0) {
+      s += fx2 * (1 - y);
+      y--;
+    }
+    s += ry2 * ((4 * x) + 6);
+  }
+
+  for (x = rx, y = 0, s = 2 * rx2 + ry2 * (1 - 2 * rx); rx2 * y <= ry2 * x; y++) {
+    b.hline(x0 - x, y0 - y, x + x + 1, c);
+    b.hline(x0 - x, y0 + y, x + x + 1, c);
+    if (s >= 0) {
+      s += fy2 * (1 - x);
+      x--;
+    }
+    s += rx2 * ((4 * y) + 6);
+  }
+}
+
+// Trapezoids: one edge setup per side and x stepped in 16.16 per row,
+// instead of two triangles that each set up three edges and both fill
+// the shared diagonal. 64-bit accumulators since near building
+// corners land far off screen
+static inline int64_t edgeStep(int32_t dx, int32_t dy) {
+  return dy ? ((int64_t)dx << 16) / dy : 0;
+}
+
+template <typename T>
+static void bandTrapH(const Band<T>& b, const int32_t* a, T c) {
+  int32_t ya = a[0], xla = a[1], xra = a[2], yb = a[3], xlb = a[4], xrb = a[5];
+  int32_t y0 = max(ya, b.lo), y1 = min(min(yb, a[6] - 1), b.hi);
+  if (y0 > y1) return;
+
+  if (ya == yb) {
+    int32_t l = min(min(xla, xra), min(xlb, xrb));
+    int32_t r = max(max(xla, xra), max(xlb, xrb));
+    b.hline(l, ya, r - l + 1, c);
+    return;
+  }
+
+  int64_t dl = edgeStep(xlb - xla, yb - ya), dr = edgeStep(xrb - xra, yb - ya);
+  int64_t xl = ((int64_t)xla << 16) + (y0 - ya) * dl;
+  int64_t xr = ((int64_t)xra << 16) + (y0 - ya) * dr;
+  for (int32_t y = y0; y <= y1; y++, xl += dl, xr += dr) {
+    int32_t l = (int32_t)(xl >> 16), r = (int32_t)(xr >> 16);
+    if (l > r) swap32(l, r);
+    b.hline(l, y, r - l + 1, c);
+  }
+}
+
+// Each row runs between the two vertical edges where it crosses them,
+// else between where it crosses the top or bottom edge
+template <typename T>
+static void bandTrapV(const Band<T>& b, const int32_t* a, T c) {
+  int32_t xa = a[0], yta = a[1], yba = a[2], xb = a[3], ytb = a[4], ybb = a[5];
+  int32_t y0 = max(min(yta, ytb), b.lo);
+  int32_t y1 = min(min(max(yba, ybb), a[6] - 1), b.hi);
+  if (y0 > y1) return;
+
+  int64_t kt = edgeStep(xb - xa, ytb - yta), kb = edgeStep(xb - xa, ybb - yba);
+  int64_t xt = ((int64_t)xa << 16) + (y0 - yta) * kt;
+  int64_t xm = ((int64_t)xa << 16) + (y0 - yba) * kb;
+  for (int32_t y = y0; y <= y1; y++, xt += kt, xm += kb) {
+    int32_t l = (y < yta) ? (int32_t)(xt >> 16) : (y > yba) ? (int32_t)(xm >> 16) : xa;
+    int32_t r = (y < ytb) ? (int32_t)(xt >> 16) : (y > ybb) ? (int32_t)(xm >> 16) : xb;
+    l = max(l, xa);
+    r = min(r, xb);
+    if (r >= l) b.hline(l, y, r - l + 1, c);
+  }
+}
+
+// One recorded span of a gfxSpanRow band, in layer columns
+struct SpanRec {
+  int16_t  a, b;
+  uint16_t c;
+};
+
+template <typename T>
+static void bandSpans(const Band<T>& b, const GfxCmd& k) {
+  const SpanRec* sp = (const SpanRec*)k.p;
+  int32_t y1 = min((int32_t)k.y1, b.hi);
+  for (int32_t y = max((int32_t)k.y0, b.lo); y <= y1; y++) {
+    T* o = b.buf + y * b.w;
+    for (int i = 0; i < k.a[0]; i++) {
+      fillPx(o + sp[i].a, sp[i].b - sp[i].a, (T)sp[i].c);
+      b.count(sp[i].b - sp[i].a);
+    }
+  }
+}
+
+template <typename T>
+static void bandBlit(const Band<T>& b, const GfxCmd& k) {
+  const uint16_t* src = (const uint16_t*)k.p;
+  int32_t x = k.a[0], y = k.a[1], w = k.a[2], h = k.a[3], sw = k.a[5], sh = k.a[6];
+
+  // 16.16 source steps, sampling pixel centres
+  int32_t du = (sw << 16) / w;
+  int32_t dv = (sh << 16) / h;
+  int32_t x0 = max(x, (int32_t)0), x1 = min(x + w, b.w);
+  int32_t y0 = max(y, b.lo), y1 = min(min(y + h, k.a[4]), b.hi + 1);
+  if (x0 >= x1 || y0 >= y1) return;
+
+  int32_t u0 = (x0 - x) * du + (du >> 1);
+  int32_t v  = (y0 - y) * dv + (dv >> 1);
+  for (int32_t py = y0; py < y1; py++, v += dv) {
+    const uint16_t* s = src + (v >> 16) * sw;
+    T* o = b.buf + py * b.w;
+    int32_t u = u0;
+    for (int32_t px = x0; px < x1; px++, u += du) {
+      uint16_t c = s[u >> 16];
+      if (c != k.c) {
+        o[px] = (sizeof(T) == 1) ? (T)colorIndex(swap16(c)) : (T)c;
+        b.count(1);
+      }
+    }
+  }
+}
+
+// Wrapping 2*SCR_W strip, point-sampled straight between the buffers
+// (both byte-swapped, or the indexed copy of the strip)
+template <typename T>
+static void bandBackground(const Band<T>& b, const GfxCmd& k) {
+  int32_t x = k.a[0], bw = k.a[1];
+  int32_t y1 = min(k.a[2] - 1, b.hi);
+  int step = 1 << shX;
+  for (int32_t wy = max((int32_t)0, b.lo); wy <= y1; wy++) {
+    const uint16_t* s = (const uint16_t*)k.p + (wy << shY) * bw;
+    const uint8_t* s8 = k.q ? (const uint8_t*)k.q + (wy << shY) * bw : nullptr;
+    T* d = b.buf + wy * b.w;
+    b.count(b.w);
+    if (sizeof(T) == 2 && !shX) {
+      int32_t n = min(b.w, bw - x);
+      memcpy(d, s + x, n * sizeof(T));
+      memcpy(d + n, s, (b.w - n) * sizeof(T));
+      continue;
+    }
+    int32_t sx = x;
+    for (int32_t wx = 0; wx < b.w; wx++) {
+      if (sizeof(T) == 2) d[wx] = (T)s[sx];
+      else                d[wx] = (T)(s8 ? s8[sx] : colorIndex(swap16(s[sx])));
+      sx += step;
+      if (sx >= bw) sx -= bw;
+    }
+  }
+}
+
+template <typename T>
+static void execOn(const Band<T>& b, const GfxCmd& k) {
+  const int32_t* a = k.a;
+  T c = (T)k.c;
+  switch (k.op) {
+    case OP_RECT:       b.rect(a[0], a[1], a[2], a[3], c); break;
+    case OP_LINE:       bandLine(b, a[0], a[1], a[2], a[3], c); break;
+    case OP_PIXEL:      b.pixel(a[0], a[1], c); break;
+    case OP_TRI:        bandTriangle(b, a[0], a[1], a[2], a[3], a[4], a[5], a[6], c); break;
+    case OP_CIRCLE:     bandCircle(b, a[0], a[1], a[2], c); break;
+    case OP_ELLIPSE:    bandEllipse(b, a[0], a[1], a[2], a[3], c); break;
+    case OP_RING:       bandRing(b, a[0], a[1], a[2], c); break;
+    case OP_ELLIPSE_RING: bandEllipseRing(b, a[0], a[1], a[2], a[3], c); break;
+    case OP_SPANS:      bandSpans(b, k); break;
+    case OP_TRAP_H:     bandTrapH(b, a, c); break;
+    case OP_TRAP_V:     bandTrapV(b, a, c); break;
+    case OP_BLIT:       bandBlit(b, k); break;
+    case OP_BACKGROUND: bandBackground(b, k); break;
+  }
+}
+
+static inline TFT_eSprite& layer() { return direct() ? spr : worldSpr; }
+
+int gfxLayerRows() {
+  return layer().height();
+}
+
+template <typename T>
+static void execInto(TFT_eSprite& dst, const GfxCmd& k, int lo, int hi) {
+  Band<T> b = { (T*)dst.getPointer(), dst.width(), lo, hi, 0 };
+  execOn(b, k);
+#if DRAW_STATS
+  dsCount(k.stage, DP_OTHER, 0, b.px);
+#endif
+}
+
+void gfxExec(const GfxCmd& k, int lo, int hi) {
+  if (worldIndexed) execInto<uint8_t>(layer(), k, lo, hi);
+  else              execInto<uint16_t>(layer(), k, lo, hi);
+}
+
+#if DRAW_STATS
+static const uint8_t opPrim[] = {
+  DP_RECT, DP_OTHER, DP_PIXEL, DP_TRI, DP_OTHER, DP_OTHER, DP_OTHER,   // RECT .. RING
+  DP_OTHER, DP_RECT, DP_TRI, DP_TRI, DP_OTHER, DP_OTHER                // ELLIPSE_RING .. BACKGROUND
+};
+#endif
+
+// Clamp the command's rows to the layer, then record it or draw it now
+static void submit(GfxCmd& k, int32_t y0, int32_t y1, bool record = true) {
+#if DRAW_STATS
+  // A span row stands for one fill per span
+  k.stage = dsStage;
+  dsCount(dsStage, opPrim[k.op], k.op == OP_SPANS ? k.a[0] : 1, 0);
+#endif
+  y0 = max(y0, (int32_t)0);
+  y1 = min(y1, (int32_t)gfxLayerRows() - 1);
+  if (y0 > y1) return;
+  k.y0 = (int16_t)y0;
+  k.y1 = (int16_t)y1;
+  if (record && dlThreads) dlRecord(k);
+  else                     gfxExec(k, y0, y1);
+}
+
+// Every field set, op arguments past the list zeroed; submit() fills
+// in the rows and the stage
+static inline GfxCmd makeCmd(uint8_t op, uint16_t c, std::initializer_list<int32_t> args,
+                             const void* p = nullptr, const void* q = nullptr) {
+  GfxCmd k;
+  k.op = op;
+  k.y0 = k.y1 = 0;
+  k.c  = c;
+  int i = 0;
+  for (int32_t v : args) k.a[i++] = v;
+  while (i < 7) k.a[i++] = 0;
+#if DRAW_STATS
+  k.stage = 0;
+#endif
+  k.p = p;
+  k.q = q;
+  return k;
+}
+
+// Colour in the layer's pixel format
+static inline uint16_t px(uint16_t c) {
+  return worldIndexed ? colorIndex(c) : swap16(c);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  WORLD PRIMITIVES
+//  Edges are shifted independently so neighbouring spans still
+//  meet; anything non-empty keeps at least one pixel so thin lane
+//  marks and posts don't vanish at half resolution
+// ═══════════════════════════════════════════════════════════════
+
+static inline void scaleSpan(int32_t& a, int32_t& len, uint8_t sh) {
+  int32_t b = (a + len) >> sh;
+  a >>= sh;
+  len = max(b - a, (int32_t)1);
+}
+
+void gfxFillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t c) {
+  if (w <= 0 || h <= 0) return;
+  scaleSpan(x, w, shX);
+  scaleSpan(y, h, shY);
+  GfxCmd k = makeCmd(OP_RECT, px(c), { x, y, w, h });
+  submit(k, y, y + h - 1);
+}
+
+void gfxDrawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t c) {
+  if (w <= 0) return;
+  scaleSpan(x, w, shX);
+  y >>= shY;
+  GfxCmd k = makeCmd(OP_RECT, px(c), { x, y, w, 1 });
+  submit(k, y, y);
+}
+
+void gfxDrawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t c) {
+  GfxCmd k = makeCmd(OP_LINE, px(c), { x0 >> shX, y0 >> shY, x1 >> shX, y1 >> shY });
+  submit(k, min(k.a[1], k.a[3]), max(k.a[1], k.a[3]));
+}
+
+void gfxDrawPixel(int32_t x, int32_t y, uint16_t c) {
+  GfxCmd k = makeCmd(OP_PIXEL, px(c), { x >> shX, y >> shY });
+  submit(k, k.a[1], k.a[1]);
+}
+
+void gfxFillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                     int32_t x2, int32_t y2, int32_t clipY, uint16_t c) {
+  clipY >>= shY;
+  GfxCmd k = makeCmd(OP_TRI, px(c), { x0 >> shX, y0 >> shY, x1 >> shX, y1 >> shY,
+                                      x2 >> shX, y2 >> shY, clipY });
+  submit(k, min(k.a[1], min(k.a[3], k.a[5])), min(max(k.a[1], max(k.a[3], k.a[5])), clipY - 1));
+}
+
+void gfxFillCircle(int32_t x, int32_t y, int32_t r, uint16_t c) {
+  if (!shY) {
+    GfxCmd k = makeCmd(OP_CIRCLE, px(c), { x, y, r });
+    submit(k, y - r, y + r);
+    return;
+  }
+  // Squashed vertically at 320x120, so it becomes an ellipse
+  GfxCmd k = makeCmd(OP_ELLIPSE, px(c), { x >> shX, y >> shY, r >> shX, r >> shY });
+  submit(k, k.a[1] - k.a[3], k.a[1] + k.a[3]);
+}
+
+void gfxDrawCircle(int32_t x, int32_t y, int32_t r, uint16_t c) {
+  if (!shY) {
+    GfxCmd k = makeCmd(OP_RING, px(c), { x, y, r });
+    submit(k, y - r, y + r);
+    return;
+  }
+  // Same as gfxFillCircle: each axis scaled by its own shift
+  GfxCmd k = makeCmd(OP_ELLIPSE_RING, px(c), { x >> shX, y >> shY, r >> shX, r >> shY });
+  submit(k, k.a[1] - k.a[3], k.a[1] + k.a[3]);
+}
+
+void gfxFillTrapH(int32_t ya, int32_t xla, int32_t xra,
+                  int32_t yb, int32_t xlb, int32_t xrb, int32_t clipY, uint16_t c) {
+  ya >>= shY; yb >>= shY; clipY >>= shY;
+  xla >>= shX; xra >>= shX; xlb >>= shX; xrb >>= shX;
+  if (ya > yb) { swap32(ya, yb); swap32(xla, xlb); swap32(xra, xrb); }
+  GfxCmd k = makeCmd(OP_TRAP_H, px(c), { ya, xla, xra, yb, xlb, xrb, clipY });
+  submit(k, ya, min(yb, clipY - 1));
+}
+
+void gfxFillTrapV(int32_t xa, int32_t yta, int32_t yba,
+                  int32_t xb, int32_t ytb, int32_t ybb, int32_t clipY, uint16_t c) {
+  xa >>= shX; xb >>= shX; clipY >>= shY;
+  yta >>= shY; yba >>= shY; ytb >>= shY; ybb >>= shY;
+  if (xa > xb) { swap32(xa, xb); swap32(yta, ytb); swap32(yba, ybb); }
+  if (yta > yba) swap32(yta, yba);
+  if (ytb > ybb) swap32(ytb, ybb);
+  GfxCmd k = makeCmd(OP_TRAP_V, px(c), { xa, yta, yba, xb, ytb, ybb, clipY });
+  submit(k, min(yta, ytb), min(max(yba, ybb), clipY - 1));
+}
+
+void gfxSpanRow(int32_t y, int32_t h, const int32_t* xs, const uint16_t* cols, int n) {
+  int dw = layer().width();
+  int32_t y0 = y >> shY, y1 = (y + h - 1) >> shY;
+  if (n <= 0 || y1 < 0 || y0 >= gfxLayerRows()) return;
+
+  // Spans in layer columns, kept in the frame arena while recording.
+  // If it is full, whatever was recorded is drawn and this row goes now
+  static SpanRec now[GFX_MAX_SPANS];
+  n = min(n, GFX_MAX_SPANS);
+  SpanRec* sp = dlThreads ? frameAlloc<SpanRec>(n) : nullptr;
+  if (!sp) {
+    dlFlush();
+    sp = now;
+  }
+
+  int prev = 0, count = 0;
+  for (int i = 0; i < n; i++) {
+    int32_t x0 = xs[i], x1 = (i + 1 < n) ? xs[i + 1] : SCR_W;
+    int a = max((int)(x0 >> shX), prev);
+    int b = min((int)(x1 >> shX), dw);
+    if (x1 > x0 && b <= a && a < dw) b = a + 1;
+    if (b <= a) continue;
+    sp[count++] = { (int16_t)a, (int16_t)b, px(cols[i]) };
+    prev = b;
+  }
+  GfxCmd k = makeCmd(OP_SPANS, 0, { count }, sp);
+  submit(k, y0, y1, sp != now);
+}
+
+int gfxRowStep() {
+  return 1 << shY;
+}
+
+void gfxBlitKeyed(const uint16_t* src, int sw, int sh, int32_t x, int32_t y,
+                  int32_t w, int32_t h, int32_t clipY, uint16_t key) {
+  if (w <= 0 || h <= 0) return;
+  scaleSpan(x, w, shX);
+  scaleSpan(y, h, shY);
+  clipY >>= shY;
+  GfxCmd k = makeCmd(OP_BLIT, swap16(key), { x, y, w, h, clipY, sw, sh }, src);
+  submit(k, y, min(y + h, clipY) - 1);
+}
+
+// The strip as palette indices, redone whenever initColors() rebuilds
+// the palette; nullptr if there's no room for it
+static const uint8_t* indexedStrip(TFT_eSprite& bg) {
+  static uint8_t* strip = nullptr;
+  static const void* stripSrc = nullptr;
+  static uint16_t stripVersion = 0;
+  size_t n = (size_t)bg.width() * bg.height();
+  if (!strip) {
+#ifdef ARDUINO
+    strip = (uint8_t*)ps_malloc(n);
+#else
+    strip = (uint8_t*)malloc(n);
+#endif
+    if (!strip) {
+      Serial.println("ERROR: No room for the indexed background strip");
+      return nullptr;
+    }
+  }
+  if (stripSrc != bg.getPointer() || stripVersion != paletteVersion) {
+    const uint16_t* src = (const uint16_t*)bg.getPointer();
+    for (size_t i = 0; i < n; i++) strip[i] = colorIndex(swap16(src[i]));
+    stripSrc = bg.getPointer();
+    stripVersion = paletteVersion;
+  }
+  return strip;
+}
+
+void gfxPushBackground(TFT_eSprite& bg, int x) {
+  int rows = bg.height() >> shY;
+  GfxCmd k = makeCmd(OP_BACKGROUND, 0, { x, bg.width(), rows }, bg.getPointer(),
+                     worldIndexed ? indexedStrip(bg) : nullptr);
+  submit(k, 0, rows - 1);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  FRAME COMPOSITION
+// ═══════════════════════════════════════════════════════════════
+
+// spr sits in PSRAM, so clearing all of it every frame costs as much
+// as a full composite. Runs of dirty bands are cleared in one fillRect
+void beginOverlay() {
+  dlFlush();
+  if (direct()) return;
+  for (int b = 0; b * PRESENT_ROWS < SCR_H; ) {
+    if (!(ovBands >> b & 1)) { b++; continue; }
+    int e = b + 1;
+    while (e * PRESENT_ROWS < SCR_H && (ovBands >> e & 1)) e++;
+    spr.fillRect(0, b * PRESENT_ROWS, SCR_W, (e - b) * PRESENT_ROWS, OVERLAY_KEY);
+    b = e;
+  }
+  ovBands = 0;
+}
+
+void overlayRows(int y0, int y1) {
+  y0 = max(y0, 0);
+  y1 = min(y1, SCR_H - 1);
+  for (int b = y0 / PRESENT_ROWS; b <= y1 / PRESENT_ROWS && y0 <= y1; b++) ovBands |= 1u << b;
+}
+
+// Composite PRESENT_ROWS display rows at a time into a small SRAM
+// buffer: overlay pixel if set, else the world pixel (line and, at
+// 160x120, pixel doubled). Bands the overlay didn't mark skip spr and
+// take the world rows as they are. Sprite buffers are byte-swapped,
+// which is what pushImage sends with swapBytes off, so no per-pixel
+// conversion beyond the palette lookup for an indexed world
+void presentFrame() {
+  dlFlush();
+  if (direct()) { spr.pushSprite(0, 0); return; }
+
+  static uint16_t lineBuf[SCR_W * PRESENT_ROWS];
+  static uint16_t pal[PALETTE_SIZE];       // colPalette in sprite byte order
+  const uint16_t key = swap16(OVERLAY_KEY);
+  const uint16_t* ov = (const uint16_t*)spr.getPointer();
+  const uint16_t* wd = (const uint16_t*)worldSpr.getPointer();
+  const uint8_t* wd8 = (const uint8_t*)worldSpr.getPointer();
+  int ww = worldSpr.width();
+  if (worldIndexed)
+    for (int i = 0; i < PALETTE_SIZE; i++) pal[i] = swap16(colPalette[i]);
+
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(false);
+  tft.startWrite();
+  for (int y0 = 0; y0 < SCR_H; y0 += PRESENT_ROWS) {
+    int rows = min(PRESENT_ROWS, SCR_H - y0);
+    bool overlay = ovBands >> (y0 / PRESENT_ROWS) & 1;
+    for (int r = 0; r < rows; r++) {
+      int y = y0 + r;
+      const uint16_t* o = ov + y * SCR_W;
+      const uint16_t* w = wd + (y >> shY) * ww;
+      const uint8_t* w8 = wd8 + (y >> shY) * ww;
+      uint16_t* d = lineBuf + r * SCR_W;
+      if (!overlay) {
+        if (worldIndexed) {
+          for (int x = 0; x < SCR_W; x++) d[x] = pal[w8[x >> shX]];
+        } else if (shX) {
+          for (int x = 0; x < SCR_W; x++) d[x] = w[x >> 1];
+        } else {
+          memcpy(d, w, SCR_W * sizeof(uint16_t));
+        }
+      } else if (worldIndexed) {
+        if (shX) {
+          for (int x = 0; x < SCR_W; x++) d[x] = (o[x] != key) ? o[x] : pal[w8[x >> 1]];
+        } else {
+          for (int x = 0; x < SCR_W; x++) d[x] = (o[x] != key) ? o[x] : pal[w8[x]];
+        }
+      } else if (shX) {
+        for (int x = 0; x < SCR_W; x++) d[x] = (o[x] != key) ? o[x] : w[x >> 1];
+      } else {
+        for (int x = 0; x < SCR_W; x++) d[x] = (o[x] != key) ? o[x] : w[x];
+      }
+    }
+    tft.pushImage(0, y0, SCR_W, rows, lineBuf);
+  }
+  tft.endWrite();
+  tft.setSwapBytes(swap);
+}
@@ -0,0 +1,109 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  WORLD DRAW TARGET
+  The world renderers (sky, road, tunnels, buildings, scenery,
+  traffic) draw through these calls in full-resolution screen
+  coordinates. At WORLD_RES_FULL they go straight to spr; in the
+  reduced modes they are scaled into worldSpr, a small sprite in
+  internal SRAM, and presentFrame() doubles it back up while
+  pushing to the display, with spr composited on top as a
+  full-resolution overlay (player car, HUD). In indexed mode
+  worldSpr is an 8-bit sprite of colPalette indices (colors.h) at
+  any of the resolutions, half the bytes per fill, and presentFrame()
+  expands it through the palette on the way out. With the display
+  list on (displist.h) the calls are recorded and drawn when the
+  world is finished
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef GFX_H
+#define GFX_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// World resolution modes
+#define WORLD_RES_FULL   0        // 320x240, drawn straight into spr
+#define WORLD_RES_LINES  1        // 320x120, line doubling
+#define WORLD_RES_HALF   2        // 160x120, line and pixel doubling
+#define WORLD_RES_MODES  3
+
+#define OVERLAY_KEY      TFT_MAGENTA  // Overlay pixels left at this show the world
+#define PRESENT_ROWS     8            // Display rows composited per pushImage
+
+extern TFT_eSprite worldSpr;
+extern uint8_t worldRes;                 // Current WORLD_RES_* mode
+extern bool worldIndexed;                // worldSpr holds palette indices
+
+// Switch modes, (re)allocating worldSpr. Falls back to WORLD_RES_FULL
+// and returns false if the buffer can't be allocated.
+bool setWorldRes(uint8_t res);
+
+// Switch the world layer between RGB565 and 8-bit palette indices at
+// the current resolution. Falls back to RGB565 and returns false if
+// the buffer can't be allocated.
+bool setWorldIndexed(bool on);
+
+// ═══════════════════════════════════════════════════════════════
+//  WORLD PRIMITIVES (same arguments as the TFT_eSprite calls)
+// ═══════════════════════════════════════════════════════════════
+void gfxFillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t c);
+void gfxDrawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t c);
+void gfxDrawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t c);
+void gfxDrawPixel(int32_t x, int32_t y, uint16_t c);
+// Rows at or below clipY are skipped
+void gfxFillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                     int32_t x2, int32_t y2, int32_t clipY, uint16_t c);
+void gfxFillCircle(int32_t x, int32_t y, int32_t r, uint16_t c);
+void gfxDrawCircle(int32_t x, int32_t y, int32_t r, uint16_t c);
+
+// Trapezoid with two horizontal edges: rows ya..yb (either order, both
+// included) from [xla, xra] at ya to [xlb, xrb] at yb, x inclusive.
+// Rows at or below clipY are skipped
+void gfxFillTrapH(int32_t ya, int32_t xla, int32_t xra,
+                  int32_t yb, int32_t xlb, int32_t xrb, int32_t clipY, uint16_t c);
+
+// Trapezoid with two vertical edges: [yta, yba] at column xa to
+// [ytb, ybb] at column xb, drawn as row spans. Rows at or below clipY
+// are skipped
+void gfxFillTrapV(int32_t xa, int32_t yta, int32_t yba,
+                  int32_t xb, int32_t ytb, int32_t ybb, int32_t clipY, uint16_t c);
+
+// One row band of adjacent spans: span i covers [xs[i], xs[i + 1])
+// (the last one runs to SCR_W) in cols[i], for rows y .. y + h - 1.
+// xs must not decrease, n is at most GFX_MAX_SPANS; a span that is
+// non-empty keeps a pixel at reduced resolution
+#define GFX_MAX_SPANS    32
+void gfxSpanRow(int32_t y, int32_t h, const int32_t* xs, const uint16_t* cols, int n);
+
+// Screen rows that map to one world row (1, or 2 in the reduced modes)
+int gfxRowStep();
+
+// src (sw x sh, sprite byte order) scaled to w x h at (x, y), nearest
+// sample, skipping key pixels and rows at or below clipY
+void gfxBlitKeyed(const uint16_t* src, int sw, int sh, int32_t x, int32_t y,
+                  int32_t w, int32_t h, int32_t clipY, uint16_t key);
+
+// Opaque copy of the wrapping 2*SCR_W parallax strip, scrolled by x
+void gfxPushBackground(TFT_eSprite& bg, int x);
+
+// ═══════════════════════════════════════════════════════════════
+//  FRAME COMPOSITION
+// ═══════════════════════════════════════════════════════════════
+
+// Call after the world and before the overlay: draws any recorded
+// world commands and, when the world has its own layer (reduced or
+// indexed modes), clears spr to OVERLAY_KEY so the car and HUD draw
+// onto a blank layer. Only the rows the last frame's overlay marked
+// are cleared, the rest still hold OVERLAY_KEY
+void beginOverlay();
+
+// Rows y0..y1 of spr get overlay pixels this frame. Everything drawn
+// after beginOverlay() has to be inside marked rows: presentFrame()
+// composites only those and copies the world everywhere else
+void overlayRows(int y0, int y1);
+
+// Send the frame to the display (replaces spr.pushSprite(0, 0))
+void presentFrame();
+
+#endif // GFX_H
@@ -0,0 +1,55 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FRAME-BUDGET GOVERNOR IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "governor.h"
+#include "config.h"
+#include "profiler.h"
+
+// Cheapest first; the last entry is the renderer's original detail
+static const RenderQuality qualityTable[QUALITY_LEVELS] = {
+  { 0, 18, 2, false, 2, 48, 8 },
+  { 1, 24, 2, false, 2, 56, 4 },
+  { 2, 28, 1, true,  1, 64, 4 },
+  { 3, 34, 1, true,  1, 72, 2 },
+  { 4, DRAW_DIST, 1, true, 0, FAR_DIST, 2 },
+};
+
+RenderQuality renderQuality = qualityTable[QUALITY_LEVELS - 1];
+
+static int overFrames  = 0;   // Consecutive frames over budget
+static int spareFrames = 0;   // Consecutive frames with room for the next level
+
+void setQualityLevel(int level) {
+  level = constrain(level, 0, QUALITY_LEVELS - 1);
+  renderQuality = qualityTable[level];
+  overFrames = spareFrames = 0;
+}
+
+// Hysteresis: a level is dropped after a few frames over budget, but
+// only raised after a long run of frames whose predicted cost at the
+// next level (road and car time grown by GOV_UP_COST) still leaves
+// GOV_UP_HEADROOM of the budget free. The gap between the two
+// thresholds keeps the level from oscillating between neighbours.
+void updateGovernor() {
+  uint32_t last = profLastFrameUs();
+  int level = renderQuality.level;
+
+  if (last > FRAME_BUDGET_US) {
+    spareFrames = 0;
+    if (++overFrames >= GOV_DOWN_FRAMES && level > 0) setQualityLevel(level - 1);
+    return;
+  }
+  overFrames = 0;
+
+  if (level == QUALITY_LEVELS - 1) return;
+  uint32_t scalable  = profStageUs(PROF_ROAD) + profStageUs(PROF_CAR);
+  float    predicted = profFrameUs() + scalable * GOV_UP_COST;
+  if (predicted < FRAME_BUDGET_US * GOV_UP_HEADROOM) {
+    if (++spareFrames >= GOV_UP_FRAMES) setQualityLevel(level + 1);
+  } else {
+    spareFrames = 0;
+  }
+}
@@ -0,0 +1,36 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FRAME-BUDGET GOVERNOR
+  Picks a render quality level every frame from the profiler's
+  stage times so heavy scenes (tunnel mouths, dense city blocks)
+  trade detail for frame rate instead of dropping frames
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <Arduino.h>
+
+#define QUALITY_LEVELS 5          // 0 = cheapest, QUALITY_LEVELS - 1 = full detail
+
+// Settings the renderers read for the current frame
+struct RenderQuality {
+  uint8_t level;            // Index into the quality table
+  uint8_t drawDist;         // Segments projected and drawn (<= DRAW_DIST)
+  uint8_t roadRowStep;      // Road rows shaded per computed row (1 = every row)
+  bool    buildingDetail;   // Windows, lights and doors on buildings
+  uint8_t meshLod;          // Car mesh: 0 = textured, 1 = small tris flat, 2 = all flat
+  uint8_t farDist;          // Far-field segments past drawDist (<= FAR_DIST, 0 = none)
+  uint8_t farStep;          // Segments per far span at its near end (doubles every FAR_TIER spans)
+};
+
+extern RenderQuality renderQuality;
+
+// Force a level (clamped); also resets the governor's counters
+void setQualityLevel(int level);
+
+// Re-evaluate the level after profFrameEnd()
+void updateGovernor();
+
+#endif // GOVERNOR_H
@@ -0,0 +1,225 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  BUTTON INPUT AND LATENCY PROBE IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+// Standard headers first: the emulator's Arduino.h defines min/max/abs
+// as macros, which break them
+#include <atomic>
+#ifndef ARDUINO
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#else
+#include <esp_timer.h>
+#endif
+
+#include "input.h"
+#include "config.h"
+#include "memmap.h"
+
+struct InputEvent {
+  uint32_t us;              // When the button first moved (start of its debounce run)
+  uint8_t  held;            // BTN_BIT_* after the change
+};
+
+// Single producer (the sampler), single consumer (loop()): each side
+// only writes its own index
+static InputEvent queue[INPUT_QUEUE_LEN];
+static std::atomic<uint32_t> qHead(0), qTail(0);
+
+static const uint8_t btnPins[2] = { BTN_LEFT, BTN_RIGHT };
+
+// Sampler side
+static uint8_t  rawHeld = 0, debounced = 0;
+static uint8_t  runLen[2];                // Samples the raw level has held
+static uint32_t runStart[2];
+static bool     pending = false;          // A change still waits for room in the queue
+static uint32_t pendingUs;
+static std::atomic<uint32_t> droppedSends(0);
+
+// Loop side
+static uint8_t  held = 0;
+static bool     manual = false;           // A button took over from the autopilot
+static uint32_t lastChangeUs = 0;
+static uint32_t probeEdges[INPUT_QUEUE_LEN];
+static int      probeCount = 0;
+
+static uint32_t latHist[LAT_BUCKETS];
+static uint32_t latCount = 0, latMin = 0, latMax = 0;
+static uint64_t latSum = 0;
+
+// ═══════════════════════════════════════════════════════════════
+//  SAMPLING
+// ═══════════════════════════════════════════════════════════════
+
+static bool push(uint32_t us, uint8_t bits) {
+  uint32_t h = qHead.load(std::memory_order_relaxed);
+  if (h - qTail.load(std::memory_order_acquire) == INPUT_QUEUE_LEN) return false;
+  queue[h & (INPUT_QUEUE_LEN - 1)] = { us, bits };
+  qHead.store(h + 1, std::memory_order_release);
+  return true;
+}
+
+// A button changes once its raw level has read the same INPUT_DEBOUNCE
+// times in a row. A change that finds the queue full is folded into the
+// next one that fits, so the loop never keeps a stale state
+static void sampleButtons() {
+  uint32_t now = (uint32_t)micros();
+  for (int b = 0; b < 2; b++) {
+    uint8_t bit  = 1 << b;
+    uint8_t down = digitalRead(btnPins[b]) == LOW ? bit : 0;   // INPUT_PULLUP: LOW is pressed
+    if (down != (rawHeld & bit)) {
+      rawHeld ^= bit;
+      runLen[b]   = 0;
+      runStart[b] = now;
+    }
+    if (runLen[b] < INPUT_DEBOUNCE) runLen[b]++;
+    if (runLen[b] == INPUT_DEBOUNCE && (debounced & bit) != down) {
+      debounced ^= bit;
+      if (!pending) pendingUs = runStart[b];
+      pending = true;
+    }
+  }
+  if (pending) {
+    if (push(pendingUs, debounced)) pending = false;
+    else droppedSends++;
+  }
+}
+
+#ifdef ARDUINO
+
+static esp_timer_handle_t sampleTimer = nullptr;
+
+static void sampleTimerMain(void*) { sampleButtons(); }
+
+// esp_timer callbacks run in their own high-priority task, so a long
+// frame in loop() doesn't delay the samples
+static void startSampler() {
+  if (sampleTimer) return;
+  esp_timer_create_args_t args = {};
+  args.callback = sampleTimerMain;
+  args.name     = "buttons";
+  if (esp_timer_create(&args, &sampleTimer) != ESP_OK ||
+      esp_timer_start_periodic(sampleTimer, 1000000 / INPUT_SAMPLE_HZ) != ESP_OK) {
+    Serial.println("ERROR: Failed to start the button sampling timer");
+  }
+}
+
+#else
+
+static std::thread       sampler;
+static std::atomic<bool> samplerQuit(false);
+
+static void samplerMain() {
+  auto next = std::chrono::steady_clock::now();
+  while (!samplerQuit.load()) {
+    sampleButtons();
+    next += std::chrono::microseconds(1000000 / INPUT_SAMPLE_HZ);
+    std::this_thread::sleep_until(next);
+  }
+}
+
+static void stopSampler() {
+  samplerQuit = true;
+  if (sampler.joinable()) sampler.join();
+}
+
+// Joined at exit, like the display list pool
+static void startSampler() {
+  if (sampler.joinable()) return;
+  sampler = std::thread(samplerMain);
+  atexit(stopSampler);
+}
+
+#endif
+
+void initInput() {
+  for (int b = 0; b < 2; b++) pinMode(btnPins[b], INPUT_PULLUP);
+  memRegister("inputQueue", "input", queue, sizeof(queue), MEM_SRAM, true);
+  startSampler();
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  CONSUMING
+// ═══════════════════════════════════════════════════════════════
+
+SimInput inputTick(uint32_t us) {
+  uint32_t t = qTail.load(std::memory_order_relaxed);
+  while (t != qHead.load(std::memory_order_acquire)) {
+    const InputEvent& e = queue[t & (INPUT_QUEUE_LEN - 1)];
+    if ((int32_t)(e.us - us) > 0) break;        // Belongs to a later tick
+    held         = e.held;
+    lastChangeUs = e.us;
+    manual       = true;
+    if (probeCount < INPUT_QUEUE_LEN) probeEdges[probeCount++] = e.us;
+    qTail.store(++t, std::memory_order_release);
+  }
+
+  if (manual && !held && us - lastChangeUs > INPUT_DEMO_MS * 1000UL) manual = false;
+  if (!manual) return { true, 0, 0 };
+
+  fx_t steer = ((held & BTN_BIT_RIGHT) ? FX_ONE : 0) - ((held & BTN_BIT_LEFT) ? FX_ONE : 0);
+  return { false, steer, FX_ONE };
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  LATENCY PROBE
+// ═══════════════════════════════════════════════════════════════
+
+void inputFramePresented() {
+  if (probeCount == 0) return;
+  uint32_t now = (uint32_t)micros();
+  bool report = false;
+  for (int i = 0; i < probeCount; i++) {
+    uint32_t lat = now - probeEdges[i];
+    uint32_t b   = lat / 1000;
+    latHist[b < LAT_BUCKETS ? b : LAT_BUCKETS - 1]++;
+    if (latCount == 0 || lat < latMin) latMin = lat;
+    if (lat > latMax) latMax = lat;
+    latSum += lat;
+    if (++latCount % LAT_REPORT_EVERY == 0) report = true;
+  }
+  probeCount = 0;
+  if (report) inputLatencyReport();
+}
+
+uint32_t inputLatencyUs(int pct) {
+  if (latCount == 0) return 0;
+  uint32_t want = ((uint64_t)latCount * pct + 99) / 100, seen = 0;
+  for (int b = 0; b < LAT_BUCKETS - 1; b++) {
+    seen += latHist[b];
+    if (seen >= want && seen > 0) return min((uint32_t)(b + 1) * 1000, latMax);
+  }
+  return latMax;
+}
+
+// One row per 1 ms bucket that has edges, with a bar scaled to the
+// fullest one
+void inputLatencyReport() {
+  char line[96];
+  snprintf(line, sizeof(line), "INPUT LATENCY edge -> pushSprite, %u edges, %u queue stalls",
+           (unsigned)latCount, (unsigned)droppedSends.load());
+  Serial.println(line);
+  if (latCount == 0) return;
+  snprintf(line, sizeof(line), "min %u.%u  mean %u.%u  max %u.%u ms  p50 %u  p95 %u  p99 %u ms",
+           (unsigned)(latMin / 1000), (unsigned)(latMin / 100 % 10),
+           (unsigned)(latSum / latCount / 1000), (unsigned)(latSum / latCount / 100 % 10),
+           (unsigned)(latMax / 1000), (unsigned)(latMax / 100 % 10),
+           (unsigned)(inputLatencyUs(50) / 1000), (unsigned)(inputLatencyUs(95) / 1000),
+           (unsigned)(inputLatencyUs(99) / 1000));
+  Serial.println(line);
+
+  uint32_t most = 1;
+  for (int b = 0; b < LAT_BUCKETS; b++) most = max(most, latHist[b]);
+  for (int b = 0; b < LAT_BUCKETS; b++) {
+    if (!latHist[b]) continue;
+    int n = b < LAT_BUCKETS - 1
+          ? snprintf(line, sizeof(line), "%3d-%-3d ms %6u ", b, b + 1, (unsigned)latHist[b])
+          : snprintf(line, sizeof(line), "%3d+    ms %6u ", b, (unsigned)latHist[b]);
+    for (int k = (int)(latHist[b] * 32 / most); k > 0 && n < (int)sizeof(line) - 1; k--) line[n++] = '#';
+    line[n] = '\0';
+    Serial.println(line);
+  }
+}
@@ -0,0 +1,49 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  BUTTON INPUT AND LATENCY PROBE
+  The buttons are sampled at INPUT_SAMPLE_HZ off the frame loop (an
+  esp_timer on the ESP32, a thread in the emulator, where main.cpp
+  drives the pins from the keyboard) and debounced. Every change
+  goes into a ring buffer with the time the button first moved.
+  stepSimulation() drains it tick by tick, so a press lands on the
+  tick it happened in rather than on the next frame's first one.
+  The probe times each change from that edge to the end of the
+  first presentFrame() whose simulation used it
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <Arduino.h>
+#include "sim.h"
+
+#define INPUT_QUEUE_LEN  32       // Button changes buffered between frames (power of 2)
+#define LAT_BUCKETS      64       // Latency histogram: 1 ms buckets, the last one open-ended
+#define LAT_REPORT_EVERY 64       // Print the distribution on Serial after this many edges
+
+// Held buttons, as bits
+enum : uint8_t {
+  BTN_BIT_LEFT  = 1,
+  BTN_BIT_RIGHT = 2
+};
+
+// Configure the button pins and start sampling
+void initInput();
+
+// Apply the changes that happened up to us (micros() clock) and return
+// the input for the tick ending then: the autopilot until a button is
+// pressed and again INPUT_DEMO_MS after the last one is let go
+SimInput inputTick(uint32_t us);
+
+// The frame just finished presentFrame(): time the edges its ticks used
+void inputFramePresented();
+
+// Print the latency distribution since boot on Serial
+void inputLatencyReport();
+
+// Latency percentile (0..100) since boot in µs (bucket upper bound),
+// 0 before the first edge
+uint32_t inputLatencyUs(int pct);
+
+#endif // INPUT_H
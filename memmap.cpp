@@ -0,0 +1,109 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  MEMORY PLACEMENT MAP IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "memmap.h"
+
+#ifdef ARDUINO
+#if __has_include(<esp_memory_utils.h>)
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+#endif
+
+struct MemEntry {
+  const char* name;
+  const char* owner;
+  const void* p;
+  size_t      bytes;
+  MemRegion   want, at;
+  bool        hot;
+};
+
+static MemEntry entries[MEM_MAX_ENTRIES];
+static int      entryCount = 0;
+static bool     booted = false;             // memReport() has run
+
+static const char* const regionNames[MEM_REGIONS] = { "SRAM", "PSRAM", "FLASH" };
+
+// Buffers marked hot belong in SRAM: say so on Serial when one isn't
+static void warnIfHot(const MemEntry& e) {
+  if (!e.hot || e.at != MEM_PSRAM) return;
+  Serial.print("WARNING: hot buffer in PSRAM: ");
+  Serial.println(e.name);
+}
+
+// Region p actually lives in (the intended one when it can't be told)
+static MemRegion regionOf(const void* p, MemRegion want) {
+#ifdef ARDUINO
+  if (p) {
+    if (esp_ptr_external_ram(p)) return MEM_PSRAM;
+    if (esp_ptr_internal(p))     return MEM_SRAM;
+    if (esp_ptr_in_drom(p))      return MEM_FLASH;
+  }
+#else
+  (void)p;
+#endif
+  return want;
+}
+
+void memRegister(const char* name, const char* owner, const void* p, size_t bytes,
+                 MemRegion where, bool hot) {
+  int i = 0;
+  while (i < entryCount && strcmp(entries[i].name, name) != 0) i++;
+  if (bytes == 0) {
+    if (i < entryCount) entries[i] = entries[--entryCount];
+    return;
+  }
+  if (i == entryCount) {
+    if (entryCount == MEM_MAX_ENTRIES) {
+      Serial.println("ERROR: Memory map full, raise MEM_MAX_ENTRIES");
+      return;
+    }
+    entryCount++;
+  }
+  entries[i] = { name, owner, p, bytes, where, regionOf(p, where), hot };
+  // Before the boot report the warning comes with the table
+  if (booted) warnIfHot(entries[i]);
+}
+
+void memRegisterSprite(const char* name, const char* owner, TFT_eSprite& s,
+                       MemRegion where, bool hot) {
+  size_t bytes = s.created() ? (size_t)s.width() * s.height() * (s.getColorDepth() / 8) : 0;
+  memRegister(name, owner, s.getPointer(), bytes, where, hot);
+}
+
+uint32_t memLowHeap()  { return ESP.getMinFreeHeap(); }
+uint32_t memLowPsram() { return ESP.getMinFreePsram(); }
+
+void memReport() {
+  char line[64];
+  size_t total[MEM_REGIONS] = { 0 };
+
+  Serial.println("MEMORY MAP");
+  snprintf(line, sizeof(line), "%-12s %-10s %-6s %9s", "buffer", "owner", "where", "bytes");
+  Serial.println(line);
+  for (int i = 0; i < entryCount; i++) {
+    const MemEntry& e = entries[i];
+    total[e.at] += e.bytes;
+    // Hot buffers are flagged; "!" marks one that didn't land where it was meant to
+    snprintf(line, sizeof(line), "%-12s %-10s %-6s %9u%s%s", e.name, e.owner,
+             regionNames[e.at], (unsigned)e.bytes, e.hot ? " hot" : "", e.at != e.want ? " !" : "");
+    Serial.println(line);
+  }
+  for (int r = 0; r < MEM_REGIONS; r++) {
+    snprintf(line, sizeof(line), "total %-6s %9u", regionNames[r], (unsigned)total[r]);
+    Serial.println(line);
+  }
+  snprintf(line, sizeof(line), "heap  free %u, low %u of %u", (unsigned)ESP.getFreeHeap(),
+           (unsigned)memLowHeap(), (unsigned)ESP.getHeapSize());
+  Serial.println(line);
+  snprintf(line, sizeof(line), "PSRAM free %u, low %u of %u", (unsigned)ESP.getFreePsram(),
+           (unsigned)memLowPsram(), (unsigned)ESP.getPsramSize());
+  Serial.println(line);
+  for (int i = 0; i < entryCount; i++) warnIfHot(entries[i]);
+  booted = true;
+}
@@ -0,0 +1,47 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  MEMORY PLACEMENT MAP
+  Every long-lived buffer is registered by the module that owns it
+  with its size and the region it is meant for: internal SRAM,
+  PSRAM or flash. On the ESP32 the region actually used is read
+  back from the address (a sprite asked for PSRAM may end up in
+  SRAM, or the other way round). memReport() prints the table at
+  boot. A buffer registered as hot (random access every frame)
+  that lands in PSRAM is reported as a warning, since each cache
+  miss there costs a round trip over the SPI bus
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef MEMMAP_H
+#define MEMMAP_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#define MEM_MAX_ENTRIES  32
+
+enum MemRegion : uint8_t {
+  MEM_SRAM,     // Internal SRAM (static or heap)
+  MEM_PSRAM,    // External SPI RAM
+  MEM_FLASH,    // Constant data mapped from flash
+  MEM_REGIONS
+};
+
+// Register (or update, by name) a buffer of bytes at p. where is the
+// intended region; the actual one is checked on the ESP32. bytes == 0
+// removes the entry. name and owner must be string literals
+void memRegister(const char* name, const char* owner, const void* p, size_t bytes,
+                 MemRegion where, bool hot);
+
+// Same for a sprite's pixel buffer (removed if the sprite isn't created)
+void memRegisterSprite(const char* name, const char* owner, TFT_eSprite& s,
+                       MemRegion where, bool hot);
+
+// Print the table, the totals per region and the heap / PSRAM state
+void memReport();
+
+// Lowest free internal heap and PSRAM since boot, in bytes
+uint32_t memLowHeap();
+uint32_t memLowPsram();
+
+#endif // MEMMAP_H
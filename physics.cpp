@@ -1,6 +1,9 @@
 /*
   ═══════════════════════════════════════════════════════════════
   PHYSICS AND LOGIC IMPLEMENTATION
+  Real-time driver of the game's SimContext: runs its ticks from
+  the frame clock, publishes the float mirrors and interpolates
+  between ticks for rendering
   ═══════════════════════════════════════════════════════════════
 */
 
@@ -8,11 +11,20 @@
 #include "track.h"
 #include "utils.h"
 #include "config.h"
+#include "memmap.h"
+#include "input.h"
 #include <Arduino.h>
 
+#define TRACK_TU   ((int32_t)TOTAL_SEGS << SEG_FX_SHIFT)  // Track length in track units
+
 // ═══════════════════════════════════════════════════════════════
 //  GLOBAL VARIABLES (Definition)
 // ═══════════════════════════════════════════════════════════════
+SimContext gameSim;
+Segment*     segments    = gameSim.segments;
+const uint32_t& sceneSeed = gameSim.sceneSeed;
+TrafficCar*  trafficCars = gameSim.traffic;
+
 float cameraDepth;
 float playerZdist;
 float position   = 0;
@@ -22,7 +34,7 @@ float maxSpeed;
 float centrifugal = CENTRIFUGAL;
 
 bool  crashed     = false;
-unsigned long crashTimer = 0;
+int   crashTicks  = 0;
 unsigned long lastFrameMs;
 
 float currentLapTime = 0;
@@ -30,199 +42,121 @@ float lastLapTime    = 0;
 float bestLapTime    = 0;
 float prevPosition   = 0;
 int currentLap       = 1;
-int totalLaps        = 3;
+int totalLaps        = RACE_LAPS;
 
 // Advanced physics variables
 float velocityX      = 0;     // Lateral velocity (for drift)
 float acceleration   = 0;     // Current acceleration
 float driftAngle     = 0;     // Drift angle
 
+float renderPosition = 0;
+float renderPlayerX  = 0;
+float renderCarZ[MAX_CARS];
+unsigned long droppedTicks = 0;
+
+// Simulation clock and the previous tick, for render interpolation
+static float simAccumulator = 0;
+static bool  simPrimed      = false;  // true once a previous tick exists
+static int32_t prevTickPos, prevTickCarZ[MAX_CARS];
+static fx_t    prevTickPlayerX;
+
 // ═══════════════════════════════════════════════════════════════
-//  IMPLEMENTATION
+//  HELPERS
 // ═══════════════════════════════════════════════════════════════
 
-void initPhysics() {
-  float fovRad = FOV_DEG * PI / 180.0;
-  cameraDepth  = 1.0 / tanf(fovRad / 2.0);
-  playerZdist  = CAM_HEIGHT * cameraDepth;
-  maxSpeed     = SEG_LEN * SPEED_MULTIPLIER;
-
-  position     = 0;
-  playerX      = 0;
-  speed        = 0;
-  crashed      = false;
-  currentLapTime = 0;
-  lastLapTime    = 0;
-  bestLapTime    = 0;
-  prevPosition   = 0;
-
-  // Initialize advanced physics
-  velocityX    = 0;
-  acceleration = 0;
-  driftAngle   = 0;
+static inline float tuToWorld(int32_t z) {
+  return z * ((float)SEG_LEN / (1 << SEG_FX_SHIFT));
 }
 
-void handleInput(float dt) {
-  // === DEMO MODE: Auto-pilot with progressive acceleration ===
-
-  // Progressive acceleration (not instantaneous)
-  float targetAccel = maxSpeed * ACCEL_TARGET;
-  float accelSpeed  = ACCEL_RAMP;
-
-  if (speed < maxSpeed * ACCEL_NEAR_MAX) {
-    acceleration += accelSpeed * dt;
-    if (acceleration > targetAccel) acceleration = targetAccel;
-  } else {
-    acceleration *= ACCEL_DAMPING;
-  }
-
-  // Read current curve to anticipate the turn
-  int pSeg = findSegIdx(position + playerZdist);
-  float curCurve = segments[pSeg].curve;
-
-  // Counter-steer according to curve + return to center
-  float target = -curCurve * 0.12;
-  float steer = (target - playerX) * STEER_AUTO * dt;
-  playerX += steer;
-
-  playerX = clampF(playerX, -0.8, 0.8);
+// Copy the fixed-point state into the float globals
+static void publishState() {
+  const SimContext& c = gameSim;
+  position       = tuToWorld(c.pos);
+  prevPosition   = tuToWorld(c.prevPos);
+  playerX        = fxToF(c.playerX);
+  speed          = fxToF(c.speed);
+  acceleration   = fxToF(c.accel);
+  velocityX      = fxToF(c.velX);
+  driftAngle     = fxToF(c.drift);
+  crashed        = c.crashed;
+  crashTicks     = c.crashTicks;
+  currentLap     = c.lap;
+  totalLaps      = c.totalLaps;
+  currentLapTime = c.lapTicks     / (float)SIM_HZ;
+  lastLapTime    = c.lastLapTicks / (float)SIM_HZ;
+  bestLapTime    = c.bestLapTicks / (float)SIM_HZ;
 }
 
-void updatePhysics(float dt) {
-  int pSeg = findSegIdx(position + playerZdist);
-  int prevSegIdx = (pSeg - 1 + TOTAL_SEGS) % TOTAL_SEGS;
-
-  float spPct = speed / maxSpeed;
-
-  // === GRAVITY: Slope effect (hills/dips) ===
-  float currentY = segments[pSeg].y;
-  float prevY = segments[prevSegIdx].y;
-  float slope = (currentY - prevY) / SEG_LEN;  // Terrain slope
-
-  // Going up = slower, going down = faster
-  float gravityEffect = -slope * GRAVITY_FACTOR;
-  acceleration += gravityEffect * dt;
-
-  // === ACCELERATION WITH FRICTION ===
-  // Air and ground friction
-  float friction = FRICTION;
-  speed *= friction;
-
-  // Apply acceleration to speed
-  speed += acceleration * dt;
+// ═══════════════════════════════════════════════════════════════
+//  IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════════
 
-  // Limit speed
-  if (speed > maxSpeed) speed = maxSpeed;
-  if (speed < 0) speed = 0;
+void initPhysics(uint32_t seed) {
+  cameraDepth  = simCameraDepth();
+  playerZdist  = CAM_HEIGHT * cameraDepth;
+  maxSpeed     = SEG_LEN * SPEED_MULTIPLIER;
 
-  // === DRIFT: Lateral physics in curves ===
-  float curveForce = segments[pSeg].curve * centrifugal * spPct;
+  simInit(gameSim, seed);
+  memRegister("gameSim", "physics", &gameSim, sizeof(gameSim), MEM_SRAM, true);
 
-  // Lateral velocity increases with curve force
-  velocityX += curveForce * dt * CURVE_FORCE;
+  simAccumulator = 0;
+  simPrimed      = false;
+  droppedTicks   = 0;
 
-  // Lateral friction (car tries to return to center)
-  velocityX *= LATERAL_FRICTION;
+  publishState();
+  interpolateRenderState(1.0f);
+}
 
-  // Apply lateral velocity to position
-  playerX -= velocityX * dt;
+float stepSimulation(float frameDt) {
+  uint32_t nowUs = (uint32_t)micros();
+  simAccumulator += frameDt;
+
+  int steps = 0;
+  while (simAccumulator >= SIM_DT) {
+    if (steps == SIM_MAX_STEPS) {
+      // Frame took too long: drop the backlog instead of spiralling
+      int skipped = (int)(simAccumulator / SIM_DT);
+      droppedTicks  += skipped;
+      simAccumulator -= skipped * SIM_DT;
+      break;
+    }
 
-  // Also apply curve push (centrifugal)
-  float steerDx = dt * CENTRIFUGAL_DX * spPct;
-  playerX -= steerDx * spPct * segments[pSeg].curve * centrifugal;
+    prevTickPos     = gameSim.pos;
+    prevTickPlayerX = gameSim.playerX;
+    for (int i = 0; i < MAX_CARS; i++) prevTickCarZ[i] = gameSim.traffic[i].z;
 
-  // === VISUAL DRIFT ANGLE ===
-  // Calculate angle based on lateral velocity and forward speed
-  if (speed > 0.1f) {
-    driftAngle = atan2f(velocityX * 10.0f, speed / maxSpeed) * 0.5f;
-    driftAngle = clampF(driftAngle, -0.5f, 0.5f);
-  } else {
-    driftAngle *= 0.9f;  // Gradually reduce angle
-  }
+    // The tick catches the simulation up to nowUs minus the backlog
+    // left after it; it gets the buttons as they were at that time
+    uint32_t tickUs = nowUs - (uint32_t)((simAccumulator - SIM_DT) * 1000000.0f);
+    simTick(gameSim, inputTick(tickUs));
 
-  prevPosition = position;
-  position = loopIncrease(position, dt * speed, trackLength);
-
-  // Detect lap completion
-  if (position < prevPosition && prevPosition > trackLength * 0.9) {
-    if (currentLapTime > 5.0) {
-      lastLapTime = currentLapTime;
-      if (bestLapTime <= 0 || currentLapTime < bestLapTime)
-        bestLapTime = currentLapTime;
-
-      // Advance to next lap
-      if (currentLap < totalLaps) {
-        currentLap++;
-      } else {
-        // Race finished! Reset
-        currentLap = 1;
-      }
-    }
-    currentLapTime = 0;
-  }
-  currentLapTime += dt;
-
-  // Update traffic
-  for (int i = 0; i < MAX_CARS; i++) {
-    trafficCars[i].z = loopIncrease(trafficCars[i].z, dt * trafficCars[i].speed, trackLength);
-    if (random(0, 200) < 2) {
-      trafficCars[i].offset += (random(-1, 2)) * 0.1;
-      trafficCars[i].offset  = clampF(trafficCars[i].offset, -0.8, 0.8);
-    }
+    simAccumulator -= SIM_DT;
+    simPrimed = true;
+    steps++;
   }
-}
 
-void checkCollisions() {
-  const float playerW = 0.15;
-  int pSeg = findSegIdx(position + playerZdist);
-  Segment& s = segments[pSeg];
-
-  // Collisions with traffic
-  for (int i = 0; i < MAX_CARS; i++) {
-    int cs = findSegIdx(trafficCars[i].z);
-    int d  = abs(cs - pSeg);
-    if (d > 3 && d < TOTAL_SEGS - 3) continue;
-    if (speed > trafficCars[i].speed && overlapChk(playerX, playerW, trafficCars[i].offset, 0.15)) {
-      speed = trafficCars[i].speed * 0.7;
-      position = loopIncrease(position, -(speed * 0.05), trackLength);
-      if (speed > maxSpeed * 0.5) {
-        crashed = true;
-        crashTimer = millis();
-      }
-    }
-  }
+  publishState();
 
-  // Collisions with tunnel walls
-  if (s.tunnel) {
-    const float wallX = 0.95f;
-    if (playerX < -wallX || playerX > wallX) {
-      playerX = clampF(playerX, -wallX, wallX);
-      velocityX = 0.0f;
-      speed *= 0.3f;
-      if (speed > maxSpeed * 0.35f) {
-        crashed = true;
-        crashTimer = millis();
-      }
-    }
-  }
+  // Before the first tick there is nothing to blend from
+  return simPrimed ? simAccumulator / SIM_DT : 1.0f;
+}
 
-  // Collisions with sprites
-  if (playerX < -1.0 || playerX > 1.0) {
-    if (s.spriteType >= 0 && overlapChk(playerX, playerW, s.spriteOffset, 0.4)) {
-      speed *= 0.2;
-      if (speed > maxSpeed * 0.25) {
-        crashed = true;
-        crashTimer = millis();
-      }
-    }
-  }
+// Blend two track positions, taking the shortest way around the loop
+static float lerpTrackZ(int32_t z0, int32_t z1, float alpha) {
+  int32_t d = z1 - z0;
+  if (d >  TRACK_TU / 2) d -= TRACK_TU;
+  if (d < -TRACK_TU / 2) d += TRACK_TU;
+  return loopIncrease(tuToWorld(z0), tuToWorld(d) * alpha, trackLength);
+}
 
-  // Going completely off the road
-  if (playerX <= -2.4 || playerX >= 2.4) {
-    speed *= 0.5;
-    if (speed > maxSpeed * 0.4) {
-      crashed = true;
-      crashTimer = millis();
-    }
+void interpolateRenderState(float alpha) {
+  if (!simPrimed) {
+    prevTickPos     = gameSim.pos;
+    prevTickPlayerX = gameSim.playerX;
+    for (int i = 0; i < MAX_CARS; i++) prevTickCarZ[i] = gameSim.traffic[i].z;
   }
+  renderPosition = lerpTrackZ(prevTickPos, gameSim.pos, alpha);
+  renderPlayerX  = lerpF(fxToF(prevTickPlayerX), playerX, alpha);
+  for (int i = 0; i < MAX_CARS; i++)
+    renderCarZ[i] = lerpTrackZ(prevTickCarZ[i], gameSim.traffic[i].z, alpha);
 }
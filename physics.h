@@ -7,8 +7,16 @@
 #ifndef PHYSICS_H
 #define PHYSICS_H
 
+#include "config.h"
+#include "sim.h"
+
+// The race being played (track, player, traffic)
+extern SimContext gameSim;
+
 // ═══════════════════════════════════════════════════════════════
 //  GLOBAL PHYSICS VARIABLES
+//  Float mirrors of gameSim, refreshed by stepSimulation()
+//  (writing them does not affect the physics)
 // ═══════════════════════════════════════════════════════════════
 extern float cameraDepth;
 extern float playerZdist;
@@ -18,7 +26,7 @@ extern float speed;
 extern float maxSpeed;
 extern float centrifugal;
 extern bool crashed;
-extern unsigned long crashTimer;
+extern int crashTicks;             // Ticks left until crash recovery
 extern unsigned long lastFrameMs;
 extern float currentLapTime;
 extern float lastLapTime;
@@ -32,20 +40,26 @@ extern float velocityX;        // Lateral velocity (for drift)
 extern float acceleration;     // Current acceleration
 extern float driftAngle;       // Drift angle
 
+// Render state: simulation interpolated between the last two ticks
+extern float renderPosition;
+extern float renderPlayerX;
+extern float renderCarZ[MAX_CARS];
+extern unsigned long droppedTicks; // Ticks skipped because a frame took too long
+
 // ═══════════════════════════════════════════════════════════════
 //  PHYSICS FUNCTIONS
 // ═══════════════════════════════════════════════════════════════
 
-// Initialize physics variables
-void initPhysics();
-
-// Handle player input (demo autopilot mode)
-void handleInput(float dt);
+// Build track and traffic from seed and reset the race
+void initPhysics(uint32_t seed);
 
-// Update game physics
-void updatePhysics(float dt);
+// Run as many fixed SIM_DT ticks as frameDt covers (input, physics,
+// collisions, crash recovery), each with the buttons queued up to its
+// own point in time (input.h); returns the 0..1 blend factor between
+// the previous and the current tick
+float stepSimulation(float frameDt);
 
-// Check collisions
-void checkCollisions();
+// Fill the render* variables by blending the last two ticks
+void interpolateRenderState(float alpha);
 
 #endif // PHYSICS_H
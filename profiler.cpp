@@ -0,0 +1,166 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FRAME PROFILER IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "profiler.h"
+#include "config.h"
+#include "governor.h"
+#include "render_text.h"
+#include "arena.h"
+#include "memmap.h"
+#include "drawstats.h"
+#include "input.h"
+#include "gfx.h"
+
+#define PROF_EMA_SHIFT  3         // Smoothing: avg += (sample - avg) / 8
+
+bool profOverlay = PROFILER_OVERLAY;
+
+static const char* const stageNames[PROF_STAGES] = { "SIM ", "SKY ", "ROAD", "CAR ", "HUD ", "PUSH" };
+
+static unsigned long frameStart, lastMark;
+static uint32_t stageCur[PROF_STAGES];
+static uint32_t stageAvg[PROF_STAGES];   // Smoothed, µs << PROF_EMA_SHIFT
+static uint32_t frameAvg, frameLast;
+static bool primed = false;
+
+void profFrameBegin() {
+  frameStart = lastMark = micros();
+  for (int i = 0; i < PROF_STAGES; i++) stageCur[i] = 0;
+}
+
+void profMark(ProfStage s) {
+  unsigned long now = micros();
+  stageCur[s] += now - lastMark;
+  lastMark = now;
+}
+
+void profFrameEnd() {
+  frameLast = lastMark - frameStart;
+  dsFrameEnd();
+
+  // First frame seeds the averages instead of ramping up from 0
+  if (!primed) {
+    for (int i = 0; i < PROF_STAGES; i++) stageAvg[i] = stageCur[i] << PROF_EMA_SHIFT;
+    frameAvg = frameLast << PROF_EMA_SHIFT;
+    primed = true;
+    return;
+  }
+  for (int i = 0; i < PROF_STAGES; i++)
+    stageAvg[i] += (int32_t)(stageCur[i] - (stageAvg[i] >> PROF_EMA_SHIFT));
+  frameAvg += (int32_t)(frameLast - (frameAvg >> PROF_EMA_SHIFT));
+}
+
+uint32_t profLastFrameUs()          { return frameLast; }
+uint32_t profStageUs(ProfStage s)   { return stageAvg[s] >> PROF_EMA_SHIFT; }
+uint32_t profFrameUs()              { return frameAvg >> PROF_EMA_SHIFT; }
+
+// ═══════════════════════════════════════════════════════════════
+//  OVERLAY
+//  One line per stage in ms, then the frame total with FPS, the
+//  governor's quality level and the settings it currently applies,
+//  the frame arena's high-water mark, the lowest free heap and
+//  PSRAM since boot and the median / 95th percentile input latency
+//  (input.h). With DRAW_STATS, a block above it has the last
+//  frame's draw calls and thousands of pixels per render stage
+// ═══════════════════════════════════════════════════════════════
+
+#define PROF_LINES  (PROF_STAGES + 6)
+#define PROF_X      2
+#define PROF_Y      (SCR_H - PROF_LINES * TEXT_CELL_H - 2)
+
+void drawProfiler(TFT_eSprite& s) {
+  if (!profOverlay) return;
+  DS_STAGE(DS_HUD);
+
+  char buf[24];
+  int y = PROF_Y;
+#if DRAW_STATS
+  overlayRows(PROF_Y - (DS_STAGES + 1) * TEXT_CELL_H, SCR_H - 1);
+#else
+  overlayRows(PROF_Y, SCR_H - 1);
+#endif
+  for (int i = 0; i < PROF_STAGES; i++) {
+    char* p = buf;
+    memcpy(p, stageNames[i], 4); p += 4;
+    *p++ = ' ';
+    fmtFixed(p, (int32_t)(profStageUs((ProfStage)i) / 100), 1);
+    drawTextBg(s, PROF_X, y, buf, 1, TFT_WHITE, TFT_BLACK);
+    y += TEXT_CELL_H;
+  }
+
+  uint32_t frameUs = profFrameUs();
+  char* p = buf;
+  memcpy(p, "FRM ", 4); p += 4;
+  p = fmtFixed(p, (int32_t)(frameUs / 100), 1);
+  memcpy(p, " FPS ", 5); p += 5;
+  fmtInt(p, frameUs ? (int)(1000000UL / frameUs) : 0);
+  drawTextBg(s, PROF_X, y, buf, 1, TFT_YELLOW, TFT_BLACK);
+  y += TEXT_CELL_H;
+
+  p = buf;
+  memcpy(p, "Q ", 2); p += 2;
+  p = fmtInt(p, renderQuality.level);
+  *p++ = '/';
+  fmtInt(p, QUALITY_LEVELS - 1);
+  drawTextBg(s, PROF_X, y, buf, 1, TFT_GREEN, TFT_BLACK);
+  y += TEXT_CELL_H;
+
+  p = buf;
+  memcpy(p, "D", 1); p += 1;
+  p = fmtInt(p, renderQuality.drawDist);
+  *p++ = '+';
+  p = fmtInt(p, renderQuality.farDist);
+  memcpy(p, " R", 2); p += 2;
+  p = fmtInt(p, renderQuality.roadRowStep);
+  memcpy(p, " M", 2); p += 2;
+  p = fmtInt(p, renderQuality.meshLod);
+  memcpy(p, renderQuality.buildingDetail ? " W" : "  ", 3);
+  drawTextBg(s, PROF_X, y, buf, 1, TFT_GREEN, TFT_BLACK);
+  y += TEXT_CELL_H;
+
+  p = buf;
+  memcpy(p, "ARN ", 4); p += 4;
+  p = fmtFixed(p, (int32_t)(frameArenaPeak() * 10 / 1024), 1);
+  memcpy(p, "K/", 2); p += 2;
+  p = fmtInt(p, FRAME_ARENA_BYTES / 1024);
+  memcpy(p, "K", 2);
+  drawTextBg(s, PROF_X, y, buf, 1, TFT_CYAN, TFT_BLACK);
+  y += TEXT_CELL_H;
+
+  p = buf;
+  memcpy(p, "LOW ", 4); p += 4;
+  p = fmtInt(p, (int)(memLowHeap() / 1024));
+  memcpy(p, "K ", 2); p += 2;
+  p = fmtInt(p, (int)(memLowPsram() / 1024));
+  memcpy(p, "K", 2);
+  drawTextBg(s, PROF_X, y, buf, 1, TFT_CYAN, TFT_BLACK);
+  y += TEXT_CELL_H;
+
+  p = buf;
+  memcpy(p, "LAT ", 4); p += 4;
+  p = fmtInt(p, (int)(inputLatencyUs(50) / 1000));
+  *p++ = '/';
+  p = fmtInt(p, (int)(inputLatencyUs(95) / 1000));
+  memcpy(p, "ms", 3);
+  drawTextBg(s, PROF_X, y, buf, 1, TFT_CYAN, TFT_BLACK);
+
+#if DRAW_STATS
+  y = PROF_Y - (DS_STAGES + 1) * TEXT_CELL_H;
+  drawTextBg(s, PROF_X, y, "STG  CALLS   KPX", 1, TFT_ORANGE, TFT_BLACK);
+  for (int i = 0; i < DS_STAGES; i++) {
+    const DrawCount& d = dsFrame((DrawStage)i);
+    uint32_t calls = 0;
+    for (int k = 0; k < DP_PRIMS; k++) calls += d.calls[k];
+    y += TEXT_CELL_H;
+    p = buf;
+    memcpy(p, dsStageNames[i], 4); p += 4;
+    p = fmtInt(p, (int)calls, 7);
+    *p++ = ' ';
+    fmtFixed(p, (int32_t)(d.pixels / 100), 1);
+    drawTextBg(s, PROF_X, y, buf, 1, TFT_ORANGE, TFT_BLACK);
+  }
+#endif
+}
@@ -0,0 +1,47 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  FRAME PROFILER
+  Per-stage frame timing with micros(), smoothed over a few frames,
+  and a small on-screen overlay with the stage times and the
+  governor's quality level, the frame arena's high-water mark, the
+  lowest free heap and PSRAM and the input latency
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// Frame stages, in the order loop() runs them
+enum ProfStage : uint8_t {
+  PROF_SIM,     // Fixed-step simulation + render interpolation
+  PROF_SKY,     // Parallax background
+  PROF_ROAD,    // Road, tunnel, buildings, scenery, traffic
+  PROF_CAR,     // Player car mesh
+  PROF_HUD,     // HUD, crash message, overlay
+  PROF_PUSH,    // Sprite upload to the display
+  PROF_STAGES
+};
+
+extern bool profOverlay;   // Draw the overlay (starts as PROFILER_OVERLAY)
+
+// Start timing a frame (first thing in loop())
+void profFrameBegin();
+
+// Close stage s: it gets the time since the previous mark
+void profMark(ProfStage s);
+
+// Close the frame and fold its times into the smoothed averages
+void profFrameEnd();
+
+// Last frame's total and smoothed per-stage / per-frame times, in µs
+uint32_t profLastFrameUs();
+uint32_t profStageUs(ProfStage s);
+uint32_t profFrameUs();
+
+// Draw the overlay into s (bottom-left corner) if profOverlay is set
+void drawProfiler(TFT_eSprite& s);
+
+#endif // PROFILER_H
@@ -8,8 +8,13 @@
 #include "rendering.h"
 #include "config.h"
 #include "colors.h"
+#include "governor.h"
+#include "drawstats.h"
 
-void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, int sIdx, bool isLeft, bool showFront) {
+void drawBuilding(RenderPt& p0, RenderPt& p1, const Building& b, int sIdx, bool isLeft) {
+  DS_STAGE(DS_BUILDING);
+  int heightVal    = b.height;
+  uint16_t baseCol = b.color;
   int h1 = (int)(p1.scale * heightVal);
   int h0 = (int)(p0.scale * heightVal);
   // Building width MUCH WIDER (400000)
@@ -34,10 +39,11 @@ void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, i
            x1_side, p1.y - h1, x0_side, p0.y - h0, sideCol);
 
   // 2. DETAILS / WINDOWS (By Style)
-  int style = sIdx % 6;
+  int style = b.style;
   int numFloors = h0 / 25; // Approximate floors
 
-  if (numFloors > 1 && numFloors < 30) {
+  // Skipped when the frame-budget governor lowers building detail
+  if (renderQuality.buildingDetail && numFloors > 1 && numFloors < 30) {
      if (style == 0) { // STYLE 0: STANDARD (Offices)
        uint16_t winCol = rgb(220, 220, 180); // Warm light
        for (int fl = 1; fl < numFloors; fl++) {
@@ -45,16 +51,16 @@ void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, i
          int wy0 = p0.y - (int)(h0 * t);
          int wy1 = p1.y - (int)(h1 * t);
          // Simple horizontal lines
-         spr.drawLine(x0_side, wy0, x1_side, wy1, winCol);
+         gfxDrawLine(x0_side, wy0, x1_side, wy1, winCol);
        }
      }
      else if (style == 1) { // STYLE 1: GLASS TOWER (Bluish)
        uint16_t glassCol = rgb(100, 200, 255);
        // Reflective vertical lines
        int midX0 = (x0_side + x0_outer) / 2; // (Approx, only drawing on side face for now)
-       spr.drawLine(x0_side, p0.y - h0/2, x1_side, p1.y - h1/2, glassCol);
+       gfxDrawLine(x0_side, p0.y - h0/2, x1_side, p1.y - h1/2, glassCol);
        // Edge reinforcement
-       spr.drawLine(x0_side, p0.y - h0, x1_side, p1.y - h1, TFT_WHITE);
+       gfxDrawLine(x0_side, p0.y - h0, x1_side, p1.y - h1, TFT_WHITE);
      }
      else if (style == 2) { // STYLE 2: RESIDENTIAL (Brick/Orange)
        uint16_t winCol = TFT_YELLOW;
@@ -64,7 +70,7 @@ void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, i
          float t = (float)fl / numFloors;
          int wy0 = p0.y - (int)(h0 * t);
          int wy1 = p1.y - (int)(h1 * t);
-         spr.drawLine(x0_side, wy0, x1_side, wy1, winCol);
+         gfxDrawLine(x0_side, wy0, x1_side, wy1, winCol);
        }
      }
      else if (style == 3) { // STYLE 3: MODERN (White/Black)
@@ -74,7 +80,7 @@ void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, i
          float t = 0.8;
          int wy0 = p0.y - (int)(h0 * t);
          int wy1 = p1.y - (int)(h1 * t);
-         spr.drawLine(x0_side, wy0, x1_side, wy1, winCol);
+         gfxDrawLine(x0_side, wy0, x1_side, wy1, winCol);
        }
      }
      else if (style == 4) { // STYLE 4: INDUSTRIAL (Dark)
@@ -83,13 +89,13 @@ void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, i
            float t = 0.9; // Aerial obstruction light
            int wy0 = p0.y - (int)(h0 * t);
            int wy1 = p1.y - (int)(h1 * t);
-           spr.drawCircle((x0_side+x1_side)/2, (wy0+wy1)/2, 2, TFT_RED);
+           gfxDrawCircle((x0_side+x1_side)/2, (wy0+wy1)/2, 2, TFT_RED);
         }
      }
      else if (style == 5) { // STYLE 5: NIGHT / NEON
         uint16_t neonCol = (sIdx % 2 == 0) ? rgb(255, 0, 255) : rgb(0, 255, 255);
         // Vertical neon edge
-        spr.drawLine(x0_side, p0.y, x0_side, p0.y - h0, neonCol);
+        gfxDrawLine(x0_side, p0.y, x0_side, p0.y - h0, neonCol);
      }
   }
 
@@ -102,18 +108,18 @@ void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, i
            darkenCol(baseCol, 0.85));
 
   // 4. FRONT FACADE (Only if visible and safe)
-  if (showFront) {
+  if (b.front) {
     drawQuad(x0_side, p0.y, x0_outer, p0.y,
              x0_outer, p0.y - h0, x0_side, p0.y - h0,
              baseCol);
 
     // Door/entrance detail on standard facade
-    if (h0 > 15 && bw0 > 10) {
+    if (renderQuality.buildingDetail && h0 > 15 && bw0 > 10) {
        uint16_t doorCol = rgb(20, 20, 20);
        int doorH = h0 / 5;
        int doorW = bw0 / 3;
        int doorX = isLeft ? (x0_side - bw0/2 - doorW/2) : (x0_side + bw0/2 - doorW/2);
-       spr.fillRect(doorX, p0.y - doorH, doorW, doorH, doorCol);
+       gfxFillRect(doorX, p0.y - doorH, doorW, doorH, doorCol);
     }
   }
 }
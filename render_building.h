@@ -10,7 +10,7 @@
 #include <Arduino.h>
 #include "structs.h"
 
-// Draws a building in 3D
-void drawBuilding(RenderPt& p0, RenderPt& p1, int heightVal, uint16_t baseCol, int sIdx, bool isLeft, bool showFront);
+// Draws segment sIdx's slice of building b in 3D
+void drawBuilding(RenderPt& p0, RenderPt& p1, const Building& b, int sIdx, bool isLeft);
 
 #endif // RENDER_BUILDING_H
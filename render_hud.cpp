@@ -9,23 +9,65 @@
 #include "config.h"
 #include "colors.h"
 #include "physics.h"
-
-void drawSpeedometer(float speed, float maxSpeed) {
-  // Bottom-right position
-  int centerX = SCR_W - 55;
-  int centerY = SCR_H - 55;
-  int radius = 42;
+#include "render_text.h"
+#include "memmap.h"
+#include "drawstats.h"
+
+// ═══════════════════════════════════════════════════════════════
+//  LAYOUT
+// ═══════════════════════════════════════════════════════════════
+#define HUD_KEY      TFT_MAGENTA          // Transparency key of the cached layers
+#define KMH_MAX      300
+
+#define DIAL_R       42                   // Speedometer radius
+#define DIAL_SIZE    ((DIAL_R + 4) * 2)   // Cached dial sprite (bezel fits inside)
+#define DIAL_C       (DIAL_SIZE / 2)      // Dial center inside its sprite
+#define DIAL_X       (SCR_W - 55 - DIAL_C)
+#define DIAL_Y       (SCR_H - 55 - DIAL_C)
+
+#define LAP_W        90                   // Lap panel (top-left)
+#define LAP_H        36
+#define LAP_NUM_X    (5 + 4 * TEXT_CELL_W * 2)  // After "LAP " at text size 2
+#define TIME_NUM_X   (5 + 5 * TEXT_CELL_W)      // After "TIME " at text size 1
+
+#define BEST_X       (SCR_W - 82)         // Best lap line (top-right)
+#define BEST_Y       2
+#define BEST_W       72
+#define BEST_H       8
+
+// ═══════════════════════════════════════════════════════════════
+//  CACHED LAYERS (internal SRAM, rebuilt only on value change)
+// ═══════════════════════════════════════════════════════════════
+static TFT_eSprite dialBase = TFT_eSprite(&tft); // Bezel, ticks and numbers
+static TFT_eSprite dialSpr  = TFT_eSprite(&tft); // dialBase + needle + digits
+static TFT_eSprite lapSpr   = TFT_eSprite(&tft);
+static TFT_eSprite bestSpr  = TFT_eSprite(&tft);
+static bool hudCached = false;
+
+// Needle tip offsets per km/h (radius - 10), filled once by initHUD()
+static int8_t needleDX[KMH_MAX + 1];
+static int8_t needleDY[KMH_MAX + 1];
+
+static int lastKmh        = -1;
+static int lastLap        = -1;
+static int lastCentis     = -1;
+static int lastBestTenths = -1;
+
+// ═══════════════════════════════════════════════════════════════
+//  LAYER DRAWING (target sprite + origin, so the uncached
+//  fallback can draw the same thing straight into spr)
+// ═══════════════════════════════════════════════════════════════
+
+static void drawDialStatic(TFT_eSprite& s, int centerX, int centerY) {
+  int radius = DIAL_R;
 
   // Semi-transparent background
-  spr.fillCircle(centerX, centerY, radius + 3, rgb(20, 20, 20));
-  spr.drawCircle(centerX, centerY, radius + 3, TFT_DARKGREY);
-  spr.drawCircle(centerX, centerY, radius + 2, rgb(60, 60, 60));
-
-  // Calculate speed in km/h (0-300)
-  int kmh = (int)(speed * 300.0 / maxSpeed);
+  DS_SPR(s).fillCircle(centerX, centerY, radius + 3, rgb(20, 20, 20));
+  DS_SPR(s).drawCircle(centerX, centerY, radius + 3, TFT_DARKGREY);
+  DS_SPR(s).drawCircle(centerX, centerY, radius + 2, rgb(60, 60, 60));
 
   // Draw speedometer marks (0, 100, 200, 300)
-  for(int i = 0; i <= 6; i++) {
+  for (int i = 0; i <= 6; i++) {
     float angle = (-225 + i * 75) * PI / 180.0;  // From -225° to 225° (270° total)
     int x1 = centerX + cos(angle) * (radius - 8);
     int y1 = centerY + sin(angle) * (radius - 8);
@@ -33,94 +75,167 @@ void drawSpeedometer(float speed, float maxSpeed) {
     int y2 = centerY + sin(angle) * (radius - 2);
 
     uint16_t markColor = (i >= 5) ? TFT_RED : TFT_ORANGE;
-    spr.drawLine(x1, y1, x2, y2, markColor);
+    DS_SPR(s).drawLine(x1, y1, x2, y2, markColor);
 
     // Numbers every 100 km/h
     if (i % 2 == 0) {
-      int num = i * 50;
+      char num[8];
+      fmtInt(num, i * 50);
       int tx = centerX + cos(angle) * (radius - 18);
       int ty = centerY + sin(angle) * (radius - 18);
-      spr.setTextSize(1);
-      spr.setTextColor(TFT_WHITE, rgb(20, 20, 20));
-      spr.setCursor(tx - 6, ty - 4);
-      spr.print(num);
+      drawTextBg(s, tx - 6, ty - 4, num, 1, TFT_WHITE, rgb(20, 20, 20));
     }
   }
+}
 
-  // Speedometer needle
-  float needleAngle = -225 + (kmh / 300.0) * 270.0;  // Map 0-300 to -225/+45 degrees
-  needleAngle = needleAngle * PI / 180.0;
-
-  int needleX = centerX + cos(needleAngle) * (radius - 10);
-  int needleY = centerY + sin(needleAngle) * (radius - 10);
+static void drawDialDynamic(TFT_eSprite& s, int centerX, int centerY, int kmh) {
+  int needleX = centerX + needleDX[kmh];
+  int needleY = centerY + needleDY[kmh];
 
   // Needle shadow
-  spr.drawLine(centerX + 1, centerY + 1, needleX + 1, needleY + 1, rgb(10, 10, 10));
+  DS_SPR(s).drawLine(centerX + 1, centerY + 1, needleX + 1, needleY + 1, rgb(10, 10, 10));
 
   // Main needle (thicker)
   uint16_t needleColor = (kmh > 250) ? TFT_RED : (kmh > 200) ? TFT_YELLOW : TFT_WHITE;
-  spr.drawLine(centerX, centerY, needleX, needleY, needleColor);
-  spr.drawLine(centerX - 1, centerY, needleX - 1, needleY, needleColor);
-  spr.drawLine(centerX, centerY - 1, needleX, needleY - 1, needleColor);
+  DS_SPR(s).drawLine(centerX, centerY, needleX, needleY, needleColor);
+  DS_SPR(s).drawLine(centerX - 1, centerY, needleX - 1, needleY, needleColor);
+  DS_SPR(s).drawLine(centerX, centerY - 1, needleX, needleY - 1, needleColor);
 
   // Needle center
-  spr.fillCircle(centerX, centerY, 4, needleColor);
-  spr.drawCircle(centerX, centerY, 5, TFT_DARKGREY);
+  DS_SPR(s).fillCircle(centerX, centerY, 4, needleColor);
+  DS_SPR(s).drawCircle(centerX, centerY, 5, TFT_DARKGREY);
 
   // Digital speed text in the center
-  spr.setTextSize(2);
-  spr.setTextColor(needleColor, rgb(20, 20, 20));
-  spr.setCursor(centerX - 18, centerY + 12);
-  if (kmh < 100) spr.print(" ");
-  if (kmh < 10) spr.print(" ");
-  spr.print(kmh);
+  char digits[8];
+  fmtInt(digits, kmh, 3);
+  drawTextBg(s, centerX - 18, centerY + 12, digits, 2, needleColor, rgb(20, 20, 20));
 }
 
-void drawHUD(float speed, float maxSpeed, float currentLapTime, float bestLapTime) {
+static void drawLapStatic(TFT_eSprite& s, int ox, int oy) {
+  // === LAP COUNTER (Top Gear style) ===
+  DS_SPR(s).fillRect(ox, oy, LAP_W, LAP_H, TFT_BLACK);
+  DS_SPR(s).drawRect(ox, oy, LAP_W, LAP_H, TFT_RED);
+  DS_SPR(s).drawRect(ox + 1, oy + 1, LAP_W - 2, LAP_H - 2, TFT_DARKGREY);
+
+  drawTextBg(s, ox + 5, oy + 4, "LAP ", 2, TFT_RED, TFT_BLACK);
+  drawTextBg(s, ox + 5, oy + 22, "TIME ", 1, TFT_YELLOW, TFT_BLACK);
+}
+
+static void drawLapNumber(TFT_eSprite& s, int ox, int oy, int lap) {
+  DS_SPR(s).fillRect(ox + LAP_NUM_X, oy + 4, LAP_W - 2 - LAP_NUM_X, 16, TFT_BLACK);
+  char buf[16];
+  char* p = fmtInt(buf, lap);
+  *p++ = '/';
+  fmtInt(p, totalLaps);
+  drawTextBg(s, ox + LAP_NUM_X, oy + 4, buf, 2, TFT_WHITE, TFT_BLACK);
+}
+
+static void drawLapTime(TFT_eSprite& s, int ox, int oy, int centis) {
+  DS_SPR(s).fillRect(ox + TIME_NUM_X, oy + 22, LAP_W - 2 - TIME_NUM_X, 8, TFT_BLACK);
+  char buf[16];
+  fmtLapTime(buf, centis);
+  drawTextBg(s, ox + TIME_NUM_X, oy + 22, buf, 1, TFT_WHITE, TFT_BLACK);
+}
+
+static void drawBestLap(TFT_eSprite& s, int ox, int oy, int tenths) {
+  char buf[20] = "BEST ";
+  char* p = fmtFixed(buf + 5, tenths, 1);
+  *p++ = ' ';
+  *p = '\0';
+  drawTextBg(s, ox, oy, buf, 1, TFT_GREEN, TFT_BLACK);
+}
+
+static bool createLayer(TFT_eSprite& s, int w, int h) {
+  s.setColorDepth(16);
+  s.setAttribute(PSRAM_ENABLE, false); // Small and read every frame: keep in SRAM
+  return s.createSprite(w, h) != nullptr;
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  PUBLIC API
+// ═══════════════════════════════════════════════════════════════
+
+void initHUD() {
+  // Needle trig table: one entry per displayed km/h
+  for (int k = 0; k <= KMH_MAX; k++) {
+    float a = (-225 + (k / 300.0) * 270.0) * PI / 180.0;  // Map 0-300 to -225/+45 degrees
+    needleDX[k] = (int8_t)floorf(cosf(a) * (DIAL_R - 10));
+    needleDY[k] = (int8_t)floorf(sinf(a) * (DIAL_R - 10));
+  }
+
+  hudCached = createLayer(dialBase, DIAL_SIZE, DIAL_SIZE) &&
+              createLayer(dialSpr,  DIAL_SIZE, DIAL_SIZE) &&
+              createLayer(lapSpr,   LAP_W, LAP_H) &&
+              createLayer(bestSpr,  BEST_W, BEST_H);
+  if (!hudCached) {
+    Serial.println("ERROR: Failed to create HUD layers, drawing HUD uncached");
+    dialBase.deleteSprite();
+    dialSpr.deleteSprite();
+    lapSpr.deleteSprite();
+    bestSpr.deleteSprite();
+    return;
+  }
+  memRegisterSprite("dialBase", "hud", dialBase, MEM_SRAM, true);
+  memRegisterSprite("dialSpr", "hud", dialSpr, MEM_SRAM, true);
+  memRegisterSprite("lapSpr", "hud", lapSpr, MEM_SRAM, true);
+  memRegisterSprite("bestSpr", "hud", bestSpr, MEM_SRAM, true);
+
+  DS_SPR(dialBase).fillSprite(HUD_KEY);
+  drawDialStatic(dialBase, DIAL_C, DIAL_C);
+  drawLapStatic(lapSpr, 0, 0);
+
+  lastKmh = lastLap = lastCentis = lastBestTenths = -1;
+}
+
+void drawSpeedometer(float speed, float maxSpeed) {
+  // Calculate speed in km/h (0-300)
   int kmh = (int)(speed * 300.0 / maxSpeed);
+  kmh = constrain(kmh, 0, KMH_MAX);
 
-  // === LAP COUNTER (Top Gear style) ===
-  spr.fillRect(0, 0, 90, 36, TFT_BLACK);
-  spr.drawRect(0, 0, 90, 36, TFT_RED);
-  spr.drawRect(1, 1, 88, 34, TFT_DARKGREY);
-
-  // LAP X/3
-  spr.setTextSize(2);
-  spr.setTextColor(TFT_RED, TFT_BLACK);
-  spr.setCursor(5, 4);
-  spr.print("LAP ");
-  spr.setTextColor(TFT_WHITE, TFT_BLACK);
-  spr.print(currentLap);
-  spr.print("/");
-  spr.print(totalLaps);
-
-  // Current time
-  spr.setTextSize(1);
-  spr.setTextColor(TFT_YELLOW, TFT_BLACK);
-  spr.setCursor(5, 22);
-  spr.print("TIME ");
-  spr.setTextColor(TFT_WHITE, TFT_BLACK);
-  int mins = (int)currentLapTime / 60;
-  int secs = (int)currentLapTime % 60;
-  int decimals = (int)((currentLapTime - (int)currentLapTime) * 100);
-  if (mins > 0) {
-    spr.print(mins);
-    spr.print(":");
-    if (secs < 10) spr.print("0");
+  if (!hudCached) {
+    drawDialStatic(spr, DIAL_X + DIAL_C, DIAL_Y + DIAL_C);
+    drawDialDynamic(spr, DIAL_X + DIAL_C, DIAL_Y + DIAL_C, kmh);
+    return;
+  }
+
+  if (kmh != lastKmh) {
+    DS_SPR(dialBase).pushToSprite(&dialSpr, 0, 0);
+    drawDialDynamic(dialSpr, DIAL_C, DIAL_C, kmh);
+    lastKmh = kmh;
   }
-  spr.print(secs);
-  spr.print(".");
-  if (decimals < 10) spr.print("0");
-  spr.print(decimals);
-
-  if (bestLapTime > 0 && bestLapTime < 999) {
-    spr.setCursor(SCR_W - 82, 2);
-    spr.setTextColor(TFT_GREEN, TFT_BLACK);
-    spr.print("BEST ");
-    spr.print((int)bestLapTime);
-    spr.print(".");
-    spr.print((int)((bestLapTime - (int)bestLapTime) * 10));
-    spr.print(" ");
+  DS_SPR(dialSpr).pushToSprite(&spr, DIAL_X, DIAL_Y, HUD_KEY);
+}
+
+void drawHUD(float speed, float maxSpeed, float currentLapTime, float bestLapTime) {
+  DS_STAGE(DS_HUD);
+  int centis = (int)(currentLapTime * 100);
+  bool showBest = bestLapTime > 0 && bestLapTime < 999;
+  int bestTenths = showBest ? (int)(bestLapTime * 10) : -1;
+  overlayRows(0, LAP_H - 1);                        // Lap panel and best lap
+  overlayRows(DIAL_Y, DIAL_Y + DIAL_SIZE - 1);
+
+  if (!hudCached) {
+    drawLapStatic(spr, 0, 0);
+    drawLapNumber(spr, 0, 0, currentLap);
+    drawLapTime(spr, 0, 0, centis);
+    if (showBest) drawBestLap(spr, BEST_X, BEST_Y, bestTenths);
+  } else {
+    if (currentLap != lastLap) {
+      drawLapNumber(lapSpr, 0, 0, currentLap);
+      lastLap = currentLap;
+    }
+    if (centis != lastCentis) {
+      drawLapTime(lapSpr, 0, 0, centis);
+      lastCentis = centis;
+    }
+    DS_SPR(lapSpr).pushToSprite(&spr, 0, 0);
+
+    if (bestTenths != lastBestTenths) {
+      DS_SPR(bestSpr).fillSprite(HUD_KEY);
+      if (showBest) drawBestLap(bestSpr, 0, 0, bestTenths);
+      lastBestTenths = bestTenths;
+    }
+    if (showBest) DS_SPR(bestSpr).pushToSprite(&spr, BEST_X, BEST_Y, HUD_KEY);
   }
 
   // Call circular speedometer
@@ -1,6 +1,8 @@
 /*
   ═══════════════════════════════════════════════════════════════
   HUD AND SPEEDOMETER RENDERING
+  Retained mode: static parts are cached in small sprites and the
+  dynamic fields are only redrawn when their value changes
   ═══════════════════════════════════════════════════════════════
 */
 
@@ -9,6 +11,9 @@
 
 #include <Arduino.h>
 
+// Pre-render the static HUD layers (call once after the display is up)
+void initHUD();
+
 // Draws the complete HUD (lap counter, times, speedometer)
 void drawHUD(float speed, float maxSpeed, float currentLapTime, float bestLapTime);
 
@@ -12,13 +12,51 @@
 #include "physics.h"
 #include "track.h"
 #include "utils.h"
+#include "render_text.h"
+#include "governor.h"
+#include "arena.h"
+#include "memmap.h"
+#include "drawstats.h"
 #include "car2_mesh.h"
 #include "car2_texture.h"
 
+#define MESH_LOD_FLAT_AREA 40.0f  // Triangles under this many px are flat-filled at mesh LOD 1
+
+// Where the mesh rasterizes: spr, or the impostor capture sprite
+static TFT_eSprite* meshTarget = &spr;
+
+// ---------------------------------------------------------------------------
+// Car texture lookup (clamped, V flipped) with simple lighting
+// ---------------------------------------------------------------------------
+static inline uint16_t sampleCarTex(float u, float v, float light) {
+  int tx = (int)(u * (CAR2_TEX_W - 1));
+  int ty = (int)((1.0f - v) * (CAR2_TEX_H - 1));  // flip V (OBJ is bottom-up)
+  tx = max(0, min(tx, CAR2_TEX_W - 1));
+  ty = max(0, min(ty, CAR2_TEX_H - 1));
+
+#ifdef ARDUINO
+  uint16_t texel = pgm_read_word(&car2_texture[ty * CAR2_TEX_W + tx]);
+#else
+  uint16_t texel = car2_texture[ty * CAR2_TEX_W + tx];
+#endif
+
+  // Apply simple lighting (multiply channels)
+  if (light < 0.99f) {
+    uint8_t r = ((texel >> 11) & 0x1F);
+    uint8_t g = ((texel >>  5) & 0x3F);
+    uint8_t b = ( texel        & 0x1F);
+    r = (uint8_t)(r * light);
+    g = (uint8_t)(g * light);
+    b = (uint8_t)(b * light);
+    texel = (r << 11) | (g << 5) | b;
+  }
+  return texel;
+}
+
 // ---------------------------------------------------------------------------
 // Textured triangle rasterizer (affine mapping, scanline)
 // ---------------------------------------------------------------------------
-static void drawTexturedTri(
+void drawTexturedTri(
     float ax, float ay, float au, float av,
     float bx, float by, float bu, float bv,
     float cx, float cy, float cu, float cv,
@@ -72,30 +110,7 @@ static void drawTexturedTri(
       float u = uL + t * (uR - uL);
       float v = vL + t * (vR - vL);
 
-      // Sample texture (clamp)
-      int tx = (int)(u * (CAR2_TEX_W - 1));
-      int ty = (int)((1.0f - v) * (CAR2_TEX_H - 1));  // flip V (OBJ is bottom-up)
-      tx = max(0, min(tx, CAR2_TEX_W - 1));
-      ty = max(0, min(ty, CAR2_TEX_H - 1));
-
-#ifdef ARDUINO
-      uint16_t texel = pgm_read_word(&car2_texture[ty * CAR2_TEX_W + tx]);
-#else
-      uint16_t texel = car2_texture[ty * CAR2_TEX_W + tx];
-#endif
-
-      // Apply simple lighting (multiply channels)
-      if (light < 0.99f) {
-        uint8_t r = ((texel >> 11) & 0x1F);
-        uint8_t g = ((texel >>  5) & 0x3F);
-        uint8_t b = ( texel        & 0x1F);
-        r = (uint8_t)(r * light);
-        g = (uint8_t)(g * light);
-        b = (uint8_t)(b * light);
-        texel = (r << 11) | (g << 5) | b;
-      }
-
-      spr.drawPixel(x, y, texel);
+      DS_SPR(*meshTarget).drawPixel(x, y, sampleCarTex(u, v, light));
     }
   }
 }
@@ -109,10 +124,20 @@ static void renderCar2Mesh(int centerX, int centerY,
   float cosY = cosf(rotY), sinY = sinf(rotY);
   float cosP = cosf(pitch), sinP = sinf(pitch);
 
-  // Project all vertices
-  static float px[428], py[428], pz[428];
+  // Project all vertices (scratch in the frame arena, sized by the mesh)
+  size_t mark = frameMark();
+  int nvert = car2_vert_count, ntri = car2_tri_count;
+  float* px = frameAlloc<float>(nvert);
+  float* py = frameAlloc<float>(nvert);
+  float* pz = frameAlloc<float>(nvert);
+  int*   order  = frameAlloc<int>(ntri);
+  float* zdepth = frameAlloc<float>(ntri);
+  if (!px || !py || !pz || !order || !zdepth) {
+    frameRelease(mark);
+    return;
+  }
 
-  for (int i = 0; i < car2_vert_count; i++) {
+  for (int i = 0; i < nvert; i++) {
     float x = car2_verts[i].x;
     float y = car2_verts[i].y;
     float z = car2_verts[i].z;
@@ -144,10 +169,6 @@ static void renderCar2Mesh(int centerX, int centerY,
 
   // Render triangles back-to-front (painter's algorithm — average Z)
   // Build sortable list
-  static int order[312];
-  static float zdepth[312];
-  int ntri = car2_tri_count;
-
   for (int t = 0; t < ntri; t++) {
     int i0 = car2_indices[t*3+0];
     int i1 = car2_indices[t*3+1];
@@ -156,7 +177,7 @@ static void renderCar2Mesh(int centerX, int centerY,
     order[t] = t;
   }
 
-  // Insertion sort (312 elements — fast enough)
+  // Insertion sort (a few hundred elements — fast enough)
   for (int i = 1; i < ntri; i++) {
     float kd = zdepth[order[i]];
     int   ki = order[i];
@@ -210,24 +231,204 @@ static void renderCar2Mesh(int centerX, int centerY,
     float dot = fnx*lx + fny*ly + fnz*lz;
     float light = 0.35f + 0.65f * max(0.0f, dot);
 
+    // Mesh LOD from the frame-budget governor: small (or all) triangles
+    // get one flat texel from their centroid instead of texture mapping
+    int lod = renderQuality.meshLod;
+    if (lod >= 2 || (lod == 1 && cross < MESH_LOD_FLAT_AREA * 2)) {
+      float mu = (car2_verts[i0].u + car2_verts[i1].u + car2_verts[i2].u) / 3.0f;
+      float mv = (car2_verts[i0].v + car2_verts[i1].v + car2_verts[i2].v) / 3.0f;
+      DS_SPR(*meshTarget).fillTriangle(ax, ay, bx, by, cx, cy, sampleCarTex(mu, mv, light));
+      continue;
+    }
+
     drawTexturedTri(
       ax, ay, car2_verts[i0].u, car2_verts[i0].v,
       bx, by, car2_verts[i1].u, car2_verts[i1].v,
       cx, cy, car2_verts[i2].u, car2_verts[i2].v,
       light);
   }
+  frameRelease(mark);
+}
+
+// ---------------------------------------------------------------------------
+// Impostor cache
+// The in-race camera only sees the car over a small (yaw, pitch) range,
+// so each bin of that range is rendered once, on first use, into a
+// capture sprite and kept as run-length encoded rows in PSRAM. Drawing
+// a cached view is a memcpy per opaque run. Views outside the range,
+// or past IMP_CACHE_BYTES, fall back to the mesh.
+//
+// Encoding, per row from the top of the crop box: span count, then for
+// each span its x (from the box's left), length and pixels in sprite
+// byte order
+// ---------------------------------------------------------------------------
+#define IMP_CAP_W   200           // Capture sprite; the car's centre sits at
+#define IMP_CAP_H   120           // (IMP_CAP_W / 2, IMP_CAP_CY)
+#define IMP_CAP_CY  80
+
+struct CarImpostor {
+  uint16_t* data;           // nullptr = not captured yet
+  int16_t   dx, dy;         // Crop box top-left relative to the car centre
+  int16_t   h;              // Rows
+};
+
+static CarImpostor impostors[IMP_PITCH_BINS][IMP_YAW_BINS];
+static uint8_t*    impPool  = nullptr;  // IMP_CACHE_BYTES block the views are carved from
+static uint32_t    impBytes = 0;        // Used part of impPool
+static TFT_eSprite impCap = TFT_eSprite(&tft);
+
+static inline float impYawAt(int i) {
+  return -IMP_YAW_MAX + 2.0f * IMP_YAW_MAX * i / (IMP_YAW_BINS - 1);
+}
+static inline float impPitchAt(int i) {
+  return IMP_PITCH_MIN + (IMP_PITCH_MAX - IMP_PITCH_MIN) * i / (IMP_PITCH_BINS - 1);
+}
+
+static void* impAlloc(size_t bytes) {
+#ifdef ARDUINO
+  return ps_malloc(bytes);
+#else
+  return malloc(bytes);
+#endif
+}
+
+// Render one bin into the capture sprite and encode it; false if it
+// doesn't fit in the cache
+static bool captureImpostor(CarImpostor& imp, float rotY, float pitch,
+                            float camDist, float fov) {
+  if (!impCap.created()) {
+    impCap.setColorDepth(16);
+    impCap.setAttribute(PSRAM_ENABLE, true);
+    if (impCap.createSprite(IMP_CAP_W, IMP_CAP_H) == nullptr) {
+      Serial.println("ERROR: Failed to create the car impostor capture sprite");
+      return false;
+    }
+    memRegisterSprite("impCapture", "player", impCap, MEM_PSRAM, false);
+  }
+  // Always captured fully textured, whatever the governor's mesh LOD
+  uint8_t lod = renderQuality.meshLod;
+  renderQuality.meshLod = 0;
+  impCap.fillSprite(IMP_KEY);
+  meshTarget = &impCap;
+  renderCar2Mesh(IMP_CAP_W / 2, IMP_CAP_CY, rotY, pitch, camDist, fov);
+  meshTarget = &spr;
+  renderQuality.meshLod = lod;
+
+  const uint16_t key = (uint16_t)((IMP_KEY >> 8) | (IMP_KEY << 8));
+  const uint16_t* px = (const uint16_t*)impCap.getPointer();
+
+  // Crop box and encoded size
+  int x0 = IMP_CAP_W, x1 = -1, y0 = IMP_CAP_H, y1 = -1;
+  for (int y = 0; y < IMP_CAP_H; y++)
+    for (int x = 0; x < IMP_CAP_W; x++)
+      if (px[y * IMP_CAP_W + x] != key) {
+        x0 = min(x0, x); x1 = max(x1, x);
+        y0 = min(y0, y); y1 = max(y1, y);
+      }
+  if (x1 < 0) return false;
+
+  uint32_t words = 0;
+  for (int y = y0; y <= y1; y++) {
+    const uint16_t* row = px + y * IMP_CAP_W;
+    words++;
+    for (int x = x0; x <= x1; ) {
+      if (row[x] == key) { x++; continue; }
+      int s = x;
+      while (x <= x1 && row[x] != key) x++;
+      words += 2 + (x - s);
+    }
+  }
+  uint32_t bytes = words * sizeof(uint16_t);
+  if (!impPool || impBytes + bytes > IMP_CACHE_BYTES) return false;
+  uint16_t* out = (uint16_t*)(impPool + impBytes);      // bytes is even, so stays aligned
+
+  uint16_t* o = out;
+  for (int y = y0; y <= y1; y++) {
+    const uint16_t* row = px + y * IMP_CAP_W;
+    uint16_t* count = o++;
+    *count = 0;
+    for (int x = x0; x <= x1; ) {
+      if (row[x] == key) { x++; continue; }
+      int s = x;
+      while (x <= x1 && row[x] != key) x++;
+      *o++ = (uint16_t)(s - x0);
+      *o++ = (uint16_t)(x - s);
+      memcpy(o, row + s, (x - s) * sizeof(uint16_t));
+      o += x - s;
+      (*count)++;
+    }
+  }
+
+  imp = { out, (int16_t)(x0 - IMP_CAP_W / 2), (int16_t)(y0 - IMP_CAP_CY), (int16_t)(y1 - y0 + 1) };
+  impBytes += bytes;
+  return true;
+}
+
+static void blitImpostor(const CarImpostor& imp, int centerX, int centerY) {
+  uint16_t* dst = (uint16_t*)spr.getPointer();
+  const uint16_t* p = imp.data;
+  int left = centerX + imp.dx;
+  DS_COUNT(DP_OTHER, 1, 0);
+  for (int r = 0; r < imp.h; r++) {
+    int y = centerY + imp.dy + r;
+    int spans = *p++;
+    for (int s = 0; s < spans; s++) {
+      int x = left + p[0], len = p[1];
+      const uint16_t* src = p + 2;
+      p += 2 + len;
+      if (y < 0 || y >= SCR_H) continue;
+      if (x < 0)          { src -= x; len += x; x = 0; }
+      if (x + len > SCR_W) len = SCR_W - x;
+      if (len <= 0) continue;
+      memcpy(dst + y * SCR_W + x, src, len * sizeof(uint16_t));
+      DS_COUNT(DP_OTHER, 0, len);
+    }
+  }
+}
+
+// Nearest cached view, captured on first use; falls back to the mesh
+static void drawCarView(int centerX, int centerY, float rotY, float pitch,
+                        float camDist, float fov) {
+#if CAR_IMPOSTORS
+  if (fabsf(rotY) <= IMP_YAW_MAX && pitch >= IMP_PITCH_MIN && pitch <= IMP_PITCH_MAX) {
+    int yi = (int)((rotY + IMP_YAW_MAX) * (IMP_YAW_BINS - 1) / (2.0f * IMP_YAW_MAX) + 0.5f);
+    int pi = (int)((pitch - IMP_PITCH_MIN) * (IMP_PITCH_BINS - 1) / (IMP_PITCH_MAX - IMP_PITCH_MIN) + 0.5f);
+    CarImpostor& imp = impostors[pi][yi];
+    if (imp.data || captureImpostor(imp, impYawAt(yi), impPitchAt(pi), camDist, fov)) {
+      blitImpostor(imp, centerX, centerY);
+      return;
+    }
+  }
+#endif
+  renderCar2Mesh(centerX, centerY, rotY, pitch, camDist, fov);
 }
 
 // ---------------------------------------------------------------------------
 // Public API
 // ---------------------------------------------------------------------------
+void initPlayerCar() {
+  memRegister("carTexture", "player", car2_texture, sizeof(car2_texture), MEM_FLASH, true);
+  memRegister("carMesh", "player", car2_verts, sizeof(car2_verts), MEM_FLASH, true);
+  memRegister("carIndices", "player", car2_indices, sizeof(car2_indices), MEM_FLASH, true);
+#if CAR_IMPOSTORS
+  // One block for the whole cache, so the memory map has a single entry
+  // whose region check covers every view
+  if (!impPool) {
+    impPool = (uint8_t*)impAlloc(IMP_CACHE_BYTES);
+    if (!impPool) Serial.println("ERROR: No PSRAM for the car impostor cache, drawing the mesh");
+    memRegister("impostors", "player", impPool, impPool ? IMP_CACHE_BYTES : 0, MEM_PSRAM, false);
+  }
+#endif
+}
+
 void drawPlayerCar() {
+  DS_STAGE(DS_CAR);
   int centerX = SCR_CX;
   int centerY = SCR_H - 40;
 
   // Calculate actual road slope by averaging several segments
   // so the car follows the inclination smoothly (same as the camera)
-  int segIdx = findSegIdx(position + playerZdist);
+  int segIdx = findSegIdx(renderPosition + playerZdist);
   const int SLOPE_SAMPLES = 6;
   float yStart = segments[segIdx].y;
   int farIdx   = (segIdx + SLOPE_SAMPLES) % TOTAL_SEGS;
@@ -238,13 +439,13 @@ void drawPlayerCar() {
   static float smoothPitch = 0.0f;
   smoothPitch += (roadPitch - smoothPitch) * 0.15f;
 
-  float rotY  = playerX * 0.5f;
+  float rotY  = renderPlayerX * 0.5f;
   // base pitch (camera from above) + road inclination
   float pitch = 0.28f + smoothPitch;
 
   // Shadow under the car — dark flattened ellipse on the road
   // Shifted downward so it appears projected beneath the chassis
-  int shadowX  = centerX + (int)(playerX * 30.0f);
+  int shadowX  = centerX + (int)(renderPlayerX * 30.0f);
   int shadowY  = SCR_H - 18;   // higher up to sit beneath the car
   int shadowRx = 42;
   int shadowRy = 5;
@@ -256,10 +457,12 @@ void drawPlayerCar() {
     if (sy < 0 || sy >= SCR_H) continue;
     int x0 = max(0, shadowX - hw);
     int x1 = min(SCR_W - 1, shadowX + hw);
-    if (x1 > x0) spr.drawFastHLine(x0, sy, x1 - x0, shadowCol);
+    if (x1 > x0) DS_SPR(spr).drawFastHLine(x0, sy, x1 - x0, shadowCol);
   }
 
-  renderCar2Mesh(centerX, centerY, rotY, pitch, 6.5f, 130.0f);
+  // The car stays inside the impostor capture box, mesh or not
+  overlayRows(centerY - IMP_CAP_CY, SCR_H - 1);
+  drawCarView(centerX, centerY, rotY, pitch, 6.5f, 130.0f);
 }
 
 void drawStartScreen(float time) {
@@ -268,22 +471,10 @@ void drawStartScreen(float time) {
   spr.fillRect(0, 100, SCR_W, 3, TFT_RED);
   spr.fillRect(0, 105, SCR_W, 3, TFT_WHITE);
 
-  spr.setTextColor(TFT_RED);
-  spr.setTextSize(3);
-  spr.setCursor(22, 115);
-  spr.print("OUTRUN ESP32");
-
-  spr.setTextSize(2);
-  spr.setTextColor(TFT_YELLOW);
-  spr.setCursor(60, 145);
-  spr.print("3D RACING");
-
-  spr.setTextSize(1);
-  spr.setTextColor(TFT_WHITE);
-  spr.setCursor(30, 170);
-  spr.print("LEFT / RIGHT buttons to steer");
-  spr.setCursor(30, 185);
-  spr.print("Car accelerates automatically");
+  drawText(spr, 22, 115, "OUTRUN ESP32", 3, TFT_RED);
+  drawText(spr, 60, 145, "3D RACING", 2, TFT_YELLOW);
+  drawText(spr, 30, 170, "LEFT / RIGHT buttons to steer", 1, TFT_WHITE);
+  drawText(spr, 30, 185, "Car accelerates automatically", 1, TFT_WHITE);
 
   // Shadow
   spr.fillEllipse(SCR_CX, 95, 55, 18, rgb(15, 15, 15));
@@ -295,10 +486,8 @@ void drawStartScreen(float time) {
 }
 
 void drawCrashMessage() {
+  overlayRows(SCR_CY - 16, SCR_CY + 15);
   spr.fillRect(SCR_CX - 70, SCR_CY - 15, 140, 30, TFT_BLACK);
   spr.drawRect(SCR_CX - 71, SCR_CY - 16, 142, 32, TFT_RED);
-  spr.setTextSize(3);
-  spr.setTextColor(TFT_RED, TFT_BLACK);
-  spr.setCursor(SCR_CX - 55, SCR_CY - 8);
-  spr.print("CRASH!");
+  drawTextBg(spr, SCR_CX - 55, SCR_CY - 8, "CRASH!", 3, TFT_RED, TFT_BLACK);
 }
@@ -9,6 +9,9 @@
 
 #include <Arduino.h>
 
+// Register the car mesh, texture and impostor cache in the memory map
+void initPlayerCar();
+
 // Draws the player car in 3D
 void drawPlayerCar();
 
@@ -18,4 +21,11 @@ void drawStartScreen(float time);
 // Draws the crash message
 void drawCrashMessage();
 
+// Affine-textured triangle with the car texture, light = 0..1
+// (used by the car mesh; public for the primitive benchmark)
+void drawTexturedTri(float ax, float ay, float au, float av,
+                     float bx, float by, float bu, float bv,
+                     float cx, float cy, float cu, float cv,
+                     float light);
+
 #endif // RENDER_PLAYER_H
@@ -13,6 +13,11 @@
 #include "track.h"
 #include "physics.h"
 #include "render_building.h"
+#include "render_tunnel.h"
+#include "billboard.h"
+#include "governor.h"
+#include "arena.h"
+#include "drawstats.h"
 
 // Required external variables
 extern RenderPt rCache[DRAW_DIST];
@@ -20,9 +25,14 @@ extern int16_t  rClip[DRAW_DIST];
 extern TFT_eSprite bgSpr;
 extern bool bgCreated;
 
-void drawQuad(int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, uint16_t c) {
-  spr.fillTriangle(x1, y1, x2, y2, x3, y3, c);
-  spr.fillTriangle(x1, y1, x3, y3, x4, y4, c);
+void drawQuad(int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, uint16_t c, int16_t clipY) {
+  // Parallel horizontal or vertical edges go to the trapezoid fills
+  if (y1 == y2 && y3 == y4) { gfxFillTrapH(y1, x1, x2, y3, x4, x3, clipY, c); return; }
+  if (y2 == y3 && y4 == y1) { gfxFillTrapH(y1, x1, x4, y2, x2, x3, clipY, c); return; }
+  if (x1 == x2 && x3 == x4) { gfxFillTrapV(x1, y1, y2, x4, y4, y3, clipY, c); return; }
+  if (x2 == x3 && x4 == x1) { gfxFillTrapV(x1, y1, y4, x2, y2, y3, clipY, c); return; }
+  gfxFillTriangle(x1, y1, x2, y2, x3, y3, clipY, c);
+  gfxFillTriangle(x1, y1, x3, y3, x4, y4, clipY, c);
 }
 
 void drawSpriteShape(int type, int sx, int sy, float scale, int16_t clipY, int timeOfDay) {
@@ -30,51 +40,30 @@ void drawSpriteShape(int type, int sx, int sy, float scale, int16_t clipY, int t
   if (bottomY <= 0 || sx < -60 || sx > SCR_W + 60) return;
 
   switch (type) {
-    case 0: { // Pine
-      int h = (int)(scale * 28000);
-      int w = (int)(scale * 10000);
-      if (h < 3 || w < 2) return;
-      int trunkH = h / 4, trunkW = max(2, w / 5);
-      uint16_t gc = (timeOfDay == 2) ? rgb(0, 50, 10) : rgb(0, 130, 25);
-      spr.fillRect(sx - trunkW / 2, bottomY - trunkH, trunkW, trunkH, rgb(80, 50, 20));
-      spr.fillTriangle(sx, bottomY - h, sx - w / 2, bottomY - trunkH, sx + w / 2, bottomY - trunkH, gc);
+    case 0:   // Pine
+    case 1:   // Rounded tree
+    case 2:   // Bush
+      drawBillboard(type, sx, sy, scale, clipY, timeOfDay == 2);
       break;
-    }
-    case 1: { // Rounded tree
-      int h = (int)(scale * 26000);
-      int w = (int)(scale * 12000);
-      if (h < 3 || w < 2) return;
-      int trunkH = h * 2 / 3, trunkW = max(2, w / 8);
-      int leafR  = max(2, w / 2);
-      uint16_t lc = (timeOfDay == 2) ? rgb(0, 55, 12) : rgb(0, 140, 30);
-      spr.fillRect(sx - trunkW / 2, bottomY - trunkH, trunkW, trunkH, rgb(120, 80, 30));
-      spr.fillCircle(sx, bottomY - trunkH - leafR / 2, leafR, lc);
-      break;
-    }
-    case 2: { // Bush
-      int r = max(2, (int)(scale * 6000));
-      uint16_t bc = (timeOfDay == 2) ? rgb(0, 48, 10) : rgb(20, 130, 20);
-      spr.fillCircle(sx, bottomY - r, r, bc);
-      break;
-    }
     case 3: { // Rock
       int rh = max(2, (int)(scale * 6000));
       int rw = max(3, (int)(scale * 8000));
-      spr.fillRect(sx - rw / 2, bottomY - rh, rw, rh, rgb(100, 95, 90));
+      gfxFillRect(sx - rw / 2, bottomY - rh, rw, rh, rgb(100, 95, 90));
       break;
     }
     case 4: { // Post
       int ph = max(3, (int)(scale * 14000));
       int pw = max(2, 3);
-      spr.fillRect(sx - pw / 2, bottomY - ph, pw, ph, TFT_WHITE);
+      gfxFillRect(sx - pw / 2, bottomY - ph, pw, ph, TFT_WHITE);
       if (ph > 6)
-        spr.fillRect(sx - pw / 2, bottomY - ph, pw, 3, TFT_RED);
+        gfxFillRect(sx - pw / 2, bottomY - ph, pw, 3, TFT_RED);
       break;
     }
   }
 }
 
 void drawSky(float position, float playerZdist, int timeOfDay, float skyOffset) {
+  DS_STAGE(DS_SKY);
   int pSegIdx = findSegIdx(position + playerZdist);
 
   // --- INFINITE PARALLAX EFFECT (Horizon Chase style) ---
@@ -85,17 +74,16 @@ void drawSky(float position, float playerZdist, int timeOfDay, float skyOffset)
     uint16_t fallbackTop = rgb(40, 40, 80);
     uint16_t fallbackBot = rgb(150, 100, 150);
     // Simple manual gradient (rectangles)
-    spr.fillRect(0, 0, SCR_W, SCR_CY/2, fallbackTop);
-    spr.fillRect(0, SCR_CY/2, SCR_W, SCR_CY/2, fallbackBot);
+    gfxFillRect(0, 0, SCR_W, SCR_CY/2, fallbackTop);
+    gfxFillRect(0, SCR_CY/2, SCR_W, SCR_CY/2, fallbackBot);
   } else {
     // Calculate X offset with wrap-around over double buffer (640px)
     int bgX = (int)skyOffset % (SCR_W * 2);
     while (bgX < 0) bgX += (SCR_W * 2); // Ensure positive
 
-    // Draw background TWICE for seamless scrolling
+    // Draw background with wrap-around for seamless scrolling
     // The buffer is 640px wide, so the sun (at x=320) is only visible once on screen (320px)
-    bgSpr.pushToSprite(&spr, -bgX, 0);
-    bgSpr.pushToSprite(&spr, (SCR_W * 2) - bgX, 0);
+    gfxPushBackground(bgSpr, bgX);
   }
 
   // Stars at night (optional, on top of parallax)
@@ -103,17 +91,214 @@ void drawSky(float position, float playerZdist, int timeOfDay, float skyOffset)
     static const uint16_t PROGMEM stX[] = {15,45,78,120,155,190,225,260,290,310,33,67,105,145,185,230,275};
     static const uint8_t PROGMEM stY[] = {8,25,15,5,30,12,22,8,18,28,40,48,35,50,42,55,38};
     for (int i = 0; i < 17; i++) {
-      spr.drawPixel(pgm_read_word(&stX[i]), pgm_read_byte(&stY[i]), TFT_WHITE);
+      gfxDrawPixel(pgm_read_word(&stX[i]), pgm_read_byte(&stY[i]), TFT_WHITE);
     }
   }
 
   // Horizon line
-  spr.drawFastHLine(0, SCR_CY, SCR_W, rgb(100, 100, 100));
+  gfxDrawFastHLine(0, SCR_CY, SCR_W, rgb(100, 100, 100));
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  PROJECTION CACHE
+//  Camera-independent data of the segment boundaries ahead of the
+//  base segment, kept across frames in a ring: boundary n's segment,
+//  elevation and running sums of the curvature (R[n] = sum of curve,
+//  Q[n] = sum of R), from which the road centre offset at boundary n
+//  is a couple of multiply-adds. Moving on by one segment drops the
+//  nearest entry and appends one far entry, so the per-frame work
+//  left is the perspective divide, which changes with every camera
+//  step anyway. Assumes the track doesn't change after the first
+//  frame.
+// ═══════════════════════════════════════════════════════════════
+
+#define PROJ_RING  (DRAW_DIST + FAR_DIST + 1)   // Boundaries 0..DRAW_DIST + FAR_DIST
+
+struct ProjEntry {
+  float   r, q;       // Running curve sums up to this boundary
+  float   y;          // Elevation at the boundary (end of the previous segment)
+  int16_t seg;        // Segment starting at this boundary
+};
+
+static ProjEntry projRing[PROJ_RING];
+static int projBase   = -1;   // Segment of boundary 0, -1 = empty
+static int projHead   = 0;    // Ring slot of boundary 0
+static int projCount  = 0;    // Boundaries held
+static int projAppend = 0;    // Entries appended since the sums were reset
+
+static inline const ProjEntry& projAt(int n) {
+  int i = projHead + n;
+  return projRing[i >= PROJ_RING ? i - PROJ_RING : i];
+}
+
+static void projPush() {
+  const ProjEntry& last = projAt(projCount - 1);
+  int i = projHead + projCount;
+  ProjEntry& e = projRing[i >= PROJ_RING ? i - PROJ_RING : i];
+  const Segment& s = segments[last.seg];
+  e.r   = last.r + s.curve;
+  e.q   = last.q + last.r;
+  e.y   = s.y;
+  e.seg = (last.seg + 1 == TOTAL_SEGS) ? 0 : last.seg + 1;
+  projCount++;
+  projAppend++;
+}
+
+static void updateProjCache(int baseIdx, int count) {
+  int step = (projBase < 0) ? PROJ_RING
+                            : (baseIdx - projBase + TOTAL_SEGS) % TOTAL_SEGS;
+
+  // Big jumps rebuild; so does a lap's worth of appends, so the float
+  // sums stay small
+  if (step >= projCount || projAppend > TOTAL_SEGS) {
+    ProjEntry& e = projRing[0];
+    e.r = e.q = 0.0f;
+    e.y   = segments[(baseIdx - 1 + TOTAL_SEGS) % TOTAL_SEGS].y;
+    e.seg = baseIdx;
+    projHead = 0;
+    projCount = 1;
+    projAppend = 0;
+  } else {
+    projHead = (projHead + step) % PROJ_RING;
+    projCount -= step;
+  }
+  projBase = baseIdx;
+  while (projCount < count) projPush();
 }
 
+// ═══════════════════════════════════════════════════════════════
+//  FAR FIELD
+//  Past drawDist the road is drawn in spans of farStep segments,
+//  doubling every FAR_TIER spans up to FAR_STEP_MAX, as one flat
+//  grass | road | grass row band per span: no rumble, lanes,
+//  buildings or sprites. Spans are walked near to far with the hill
+//  horizon carried over from the near field, so each one only fills
+//  the rows nothing nearer covers and the near field can be drawn
+//  over it afterwards. A tunnel ends the far field (its mouth hides
+//  the rest).
+// ═══════════════════════════════════════════════════════════════
+
+static void drawFarField(int drawDist, int farDist, int farStep, int maxy,
+                         float posOff, float camX, float camY, float curveBase,
+                         const ProjEntry& e1, float cameraDepth, int fogDist) {
+  int endN  = drawDist + farDist;
+  int step  = farStep;
+  int spans = 0;
+
+  int n = drawDist;
+  float sc = cameraDepth / ((float)n * SEG_LEN - posOff);
+  const ProjEntry* e = &projAt(n);
+  int y1 = SCR_CY - (int)(sc * (e->y - camY) * SCR_CY);
+  float x1 = sc * (e->q - e1.q - (n - 1) * curveBase - camX) * SCR_CX;
+  float w1 = sc * ROAD_W * SCR_CX;
+
+  while (n < endN && maxy > 0) {
+    int next = min(n + step, endN);
+    for (int k = n + 1; k <= next; k++)
+      if (segments[projAt(k).seg].tunnel) return;
+
+    sc = cameraDepth / ((float)next * SEG_LEN - posOff);
+    e  = &projAt(next);
+    int   y2 = SCR_CY - (int)(sc * (e->y - camY) * SCR_CY);
+    float x2 = sc * (e->q - e1.q - (next - 1) * curveBase - camX) * SCR_CX;
+    float w2 = sc * ROAD_W * SCR_CX;
+
+    if (y1 > y2 && y2 < maxy) {
+      int top = max(y2, 0);
+      int bot = min(y1, maxy);
+      if (bot > top) {
+        float fogF = expFog((float)(n + next) * 0.5f / fogDist, FOG_DENSITY);
+        int cx = SCR_CX + (int)((x1 + x2) * 0.5f);
+        int hw = (int)((w1 + w2) * 0.5f);
+        int rdL = max(0, min(cx - hw, SCR_W));
+        int rdR = max(0, min(cx + hw, SCR_W));
+        uint16_t grass = lerpCol(colGrassD, colFog, fogF);
+        if (rdL > 0)     gfxFillRect(0, top, rdL, bot - top, grass);
+        if (rdR > rdL)   gfxFillRect(rdL, top, rdR - rdL, bot - top, lerpCol(colRoadD, colFog, fogF));
+        if (rdR < SCR_W) gfxFillRect(rdR, top, SCR_W - rdR, bot - top, grass);
+        maxy = top;
+      }
+    }
+
+    n = next; y1 = y2; x1 = x2; w1 = w2;
+    if (++spans == FAR_TIER) { spans = 0; step = min(step * 2, FAR_STEP_MAX); }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  ROAD ROW SHADER
+//  Across one band, screen x, half-width and projection scale are
+//  linear in the row, so each row gets its own edges and its world
+//  Z (one divide). Rumble/grass parity, lane dashes and an asphalt
+//  shade hash then follow the ground rather than the band, and the
+//  row is written as a single run of spans: grass | rumble | road
+//  with lane marks | rumble | grass
+// ═══════════════════════════════════════════════════════════════
+
+#define TRACK_LEN_I    (TOTAL_SEGS * SEG_LEN)
+#define STRIPE_LEN     (SEG_LEN * RUMBLE_LEN)   // World length of one light/dark stripe
+#define ASPHALT_SHIFT  5                        // Asphalt shade changes every 32 world units
+#define ROW_SPANS      (5 + 2 * (LANES - 1))
+
+static void drawRoadRows(const RenderPt& p0, const RenderPt& p1, int drawTop, int drawBot,
+                         float fogF, float position, float cameraDepth) {
+  // [0] = light stripe, [1] = dark stripe
+  uint16_t grass[2]  = { lerpCol(colGrassL, colFog, fogF),  lerpCol(colGrassD, colFog, fogF) };
+  uint16_t rumble[2] = { lerpCol(colRumbleL, colFog, fogF), lerpCol(colRumbleD, colFog, fogF) };
+  uint16_t road[2]   = { lerpCol(colRoadL, colFog, fogF),   lerpCol(colRoadD, colFog, fogF) };
+  uint16_t worn[2]   = { lerpCol(road[0], 0, 0.1f),          lerpCol(road[1], 0, 0.1f) };
+  uint16_t lane      = lerpCol(colLane, colFog, fogF);
+  bool lanes = p0.w > 15;
+
+  float dy = (float)(p0.y - p1.y);
+  float kx = (p0.x - p1.x) / dy;
+  float kw = (p0.w - p1.w) / dy;
+  float ks = (p0.scale - p1.scale) / dy;
+  int step = max((int)renderQuality.roadRowStep, gfxRowStep());
+
+  int32_t  xs[ROW_SPANS];
+  uint16_t cols[ROW_SPANS];
+  for (int y = drawTop; y < drawBot; y += step) {
+    float t  = y + 0.5f - p1.y;
+    int cx   = p1.x + (int)(kx * t);
+    int hw   = p1.w + (int)(kw * t);
+    float sc = p1.scale + ks * t;
+    if (sc <= 0) continue;
+
+    int32_t z     = (int32_t)(position + cameraDepth / sc) % TRACK_LEN_I;
+    int stripe    = (z / STRIPE_LEN) & 1;
+    uint32_t hash = (uint32_t)(z >> ASPHALT_SHIFT) * 2654435761u;
+    uint16_t rc   = (hash >> 31) ? worn[stripe] : road[stripe];
+
+    int rdL = cx - hw, rdR = cx + hw;
+    int rw  = max(1, hw / 6);
+    int k = 0;
+    xs[k] = 0;         cols[k++] = grass[stripe];
+    xs[k] = rdL - rw;  cols[k++] = rumble[stripe];
+    xs[k] = rdL;       cols[k++] = rc;
+    if (lanes && stripe == 0) {
+      int lw = max(1, hw / 30);
+      for (int l = 1; l < LANES; l++) {
+        int lx = rdL + 2 * hw * l / LANES - lw / 2;
+        xs[k] = lx;      cols[k++] = lane;
+        xs[k] = lx + lw; cols[k++] = rc;
+      }
+    }
+    xs[k] = rdR;       cols[k++] = rumble[stripe];
+    xs[k] = rdR + rw;  cols[k++] = grass[stripe];
+    gfxSpanRow(y, min(step, drawBot - y), xs, cols, k);
+  }
+}
+
+// Traffic car in view, listed once per frame in the frame arena
+struct VisibleCar {
+  int16_t slot;       // Draw slot (segments ahead of the camera)
+  int16_t car;        // Index into trafficCars
+};
 
 void drawRoad(float position, float playerX, float playerZdist,
               float cameraDepth, int timeOfDay) {
+  DS_STAGE(DS_FAR);
   int baseIdx = findSegIdx(position);
   float basePct = percentRemaining(position, SEG_LEN);
   float posOff  = fmodf(position, (float)SEG_LEN);
@@ -125,239 +310,151 @@ void drawRoad(float position, float playerX, float playerZdist,
   float playerY = lerpF(segments[pPrevIdx].y, segments[pSegIdx].y, pPct);
   float camY    = playerY + CAM_HEIGHT;
 
-  float curveX  = 0;
-  float curveDX = -(segments[baseIdx].curve * basePct);
   int maxy = SCR_H; // Ground horizon (rises)
-  int minCeilY = 0; // Ceiling horizon (lowers)
-
-  for (int n = 0; n < DRAW_DIST; n++) {
-    int sIdx = (baseIdx + n) % TOTAL_SEGS;
-    int prev = (sIdx - 1 + TOTAL_SEGS) % TOTAL_SEGS;
-    Segment& seg = segments[sIdx];
-
-    float camZ1 = (float)n       * SEG_LEN - posOff;
-    float camZ2 = (float)(n + 1) * SEG_LEN - posOff;
-
-    rCache[n] = {(int16_t)SCR_CX, (int16_t)SCR_H, 0, 0.0f};
-    rClip[n]  = maxy;
 
-    if (camZ1 <= cameraDepth) continue;
-
-    float p1Y = segments[prev].y;
-    float p2Y = seg.y;
-    if (n == 0) {
-      int pp = (prev - 1 + TOTAL_SEGS) % TOTAL_SEGS;
-      p1Y = lerpF(segments[pp].y, segments[prev].y, basePct);
+  // Draw distance and road row step come from the frame-budget governor
+  int drawDist = renderQuality.drawDist;
+  int farDist  = renderQuality.farDist;
+  int fogDist  = drawDist + farDist;   // Fog thins out as the far field extends the view
+  updateProjCache(baseIdx, fogDist + 1);
+
+  // Project each segment boundary once (it is the far edge of one band
+  // and the near edge of the next). Boundary 0 is always behind the
+  // camera (camZ <= 0), so it is never projected.
+  // Road centre offset at boundary n from the cached sums, bending
+  // from boundary 1 on (the first band drawn):
+  // curveX = Q[n] - Q[1] - (n - 1) * (R[1] + curve[base] * basePct)
+  const ProjEntry& e1 = projAt(1);
+  float curveBase = e1.r + segments[baseIdx].curve * basePct;
+  float camX      = playerX * ROAD_W;
+  int16_t farY    = SCR_H;
+
+  for (int n = 1; n <= drawDist; n++) {
+    const ProjEntry& e = projAt(n);
+    float camZ = (float)n * SEG_LEN - posOff;
+    if (camZ <= cameraDepth) {
+      if (n < drawDist) rCache[n] = {(int16_t)SCR_CX, (int16_t)SCR_H, 0, 0.0f};
+      continue;
     }
 
-    float sc1   = cameraDepth / camZ1;
-    float cyp1  = p1Y - camY;
-    float cxp1  = playerX * ROAD_W - curveX;
-    int16_t sy1 = SCR_CY - (int)(sc1 * cyp1 * SCR_CY);
-    int16_t sx1 = SCR_CX + (int)(sc1 * (-cxp1) * SCR_CX);
-    int16_t sw1 = (int)(sc1 * ROAD_W * SCR_CX);
-
-    float sc2   = (camZ2 > cameraDepth) ? cameraDepth / camZ2 : sc1;
-    float cyp2  = p2Y - camY;
-    float cxp2  = playerX * ROAD_W - curveX - curveDX;
-    int16_t sy2 = SCR_CY - (int)(sc2 * cyp2 * SCR_CY);
-    int16_t sx2 = SCR_CX + (int)(sc2 * (-cxp2) * SCR_CX);
-    int16_t sw2 = (int)(sc2 * ROAD_W * SCR_CX);
-
-    curveX  += curveDX;
-    curveDX += seg.curve;
-
-    rCache[n] = {sx1, sy1, sw1, sc1};
-
-    if (sy1 <= sy2)  { rClip[n] = maxy; continue; }
-    if (sy2 >= maxy) { rClip[n] = maxy; continue; }
+    float sc    = cameraDepth / camZ;
+    float cxp   = camX - (e.q - e1.q - (n - 1) * curveBase);
+    int16_t sy  = SCR_CY - (int)(sc * (e.y - camY) * SCR_CY);
+    if (n == drawDist) { farY = sy; break; }
+    int16_t sx  = SCR_CX + (int)(sc * (-cxp) * SCR_CX);
+    int16_t sw  = (int)(sc * ROAD_W * SCR_CX);
+    rCache[n] = {sx, sy, sw, sc};
+  }
+  rCache[0] = {(int16_t)SCR_CX, (int16_t)SCR_H, 0, 0.0f};
 
+  // Hill occlusion: walk the bands near to far, tracking the ground horizon
+  for (int n = 0; n < drawDist; n++) {
     rClip[n] = maxy;
+    if (rCache[n].scale <= 0) continue;
+
+    int16_t sy1 = rCache[n].y;
+    int16_t sy2 = (n + 1 < drawDist) ? rCache[n + 1].y : farY;
+    if (sy1 <= sy2 || sy2 >= maxy) continue;
 
     int drawTop = max((int)sy2, 0);
     int drawBot = min((int)sy1, maxy);
     int bandH   = drawBot - drawTop;
     if (bandH <= 0) continue;
 
-    float fogF = expFog((float)n / DRAW_DIST, FOG_DENSITY);
-    bool isLight  = ((sIdx / RUMBLE_LEN) % 2) == 0;
-    uint16_t grassCol = lerpCol(isLight ? colGrassL : colGrassD, colFog, fogF);
-    uint16_t wallCol  = isLight ? rgb(35, 32, 30) : rgb(28, 25, 22);
-    uint16_t grass    = seg.tunnel ? wallCol : grassCol;
-    uint16_t road   = lerpCol(isLight ? colRoadL   : colRoadD,   colFog, seg.tunnel ? 0 : fogF);
-    uint16_t rumble = lerpCol(isLight ? colRumbleL : colRumbleD, colFog, seg.tunnel ? 0 : fogF);
-    uint16_t lane   = lerpCol(colLane, colFog, seg.tunnel ? 0 : fogF);
-
-    // TUNNEL CEILING: Drawn in the 3D loop (back-to-front) along with the walls
-
     // Save info to draw later (we don't draw the road here)
     maxy = drawTop;
   }
 
+  if (farDist > 0)
+    drawFarField(drawDist, farDist, renderQuality.farStep, maxy, posOff,
+                 camX, camY, curveBase, e1, cameraDepth, fogDist);
+
   if (maxy > SCR_CY) {
     // Ground fill (even in tunnels, to avoid gaps)
-     spr.fillRect(0, SCR_CY, SCR_W, maxy - SCR_CY, lerpCol(colGrassD, colFog, 0.7));
+     gfxFillRect(0, SCR_CY, SCR_W, maxy - SCR_CY, lerpCol(colGrassD, colFog, 0.7));
   }
 
+  // Tunnel openings and ceiling heights from the projected edges
+  prepareTunnel(baseIdx, drawDist, camY);
+
   // --- UNIFIED 3D RENDERING: back-to-front ---
+  DS_SET_STAGE(DS_ROAD);
   // Buildings, tunnel, and road are drawn in the same loop so the painter's
   // algorithm works correctly on hills and dips.
   // rClip[n] contains the maxy calculated in the previous projection loop.
-  for (int n = DRAW_DIST - 1; n > 0; n--) {
+  for (int n = drawDist - 1; n > 0; n--) {
     int sIdx = (baseIdx + n) % TOTAL_SEGS;
-    int prevIdx = (sIdx - 1 + TOTAL_SEGS) % TOTAL_SEGS;
     Segment& seg = segments[sIdx];
-    Segment& prevSeg = segments[prevIdx];
 
     RenderPt& p1 = rCache[n];
     RenderPt& p0 = rCache[n - 1];
 
     if (p0.scale <= 0 || p1.scale <= 0) continue;
 
-    // ── TUNNEL IN 3D ──────────────────────────────────────────────────────────
+    // ── TUNNEL ────────────────────────────────────────────────────────────────
+    // The whole run (walls, ceiling, road) is drawn front to back when the
+    // loop reaches its near end; everything behind it is already down
     if (seg.tunnel) {
-       bool isLightT = ((sIdx / 3) % 2) == 0;
-       float fogT = expFog((float)n / DRAW_DIST, FOG_DENSITY);
-       uint16_t wallBase = isLightT ? rgb(80, 120, 200) : rgb(50, 80, 150);
-       uint16_t wallT = lerpCol(wallBase, TFT_BLACK, fogT * 0.85f);
-       bool isLightCeil = ((sIdx / RUMBLE_LEN) % 2) == 0;
-       uint16_t ceilColor = isLightCeil ? colRoadL : colRoadD;
-
-       float cH = 4500.0f;
-       int cy1 = SCR_CY - (int)(p1.scale * (seg.y + cH - camY) * SCR_CY);
-       int cy0 = SCR_CY - (int)(p0.scale * (prevSeg.y + cH - camY) * SCR_CY);
-
-       int roadL0 = p0.x - p0.w, roadR0 = p0.x + p0.w;
-       int roadL1 = p1.x - p1.w, roadR1 = p1.x + p1.w;
-
-       if (n == DRAW_DIST - 1) {
-         int intL = max(roadL1, 0), intR = min(roadR1, SCR_W);
-         int intTop = cy1, intBot = (int)p1.y;
-         if (intBot > intTop && intR > intL)
-           spr.fillRect(intL, intTop, intR - intL, intBot - intTop, TFT_BLACK);
-       }
-
-       drawQuad(roadL0, cy0, roadR0, cy0, roadR1, cy1, roadL1, cy1, ceilColor);
-       drawQuad(roadL0, p0.y, roadL1, p1.y, roadL1, cy1, roadL0, cy0, wallT);
-       drawQuad(roadR0, p0.y, roadR0, cy0, roadR1, cy1, roadR1, p1.y, wallT);
-
-       // CEILING LIGHTS — yellow rectangles every 4 segments
-       if ((sIdx % 4) == 0) {
-         int lx0 = (roadL0 + roadR0) / 2;
-         int lx1 = (roadL1 + roadR1) / 2;
-         int lw0 = max(2, (roadR0 - roadL0) / 4);
-         int lw1 = max(1, (roadR1 - roadL1) / 4);
-         drawQuad(lx0 - lw0/2, cy0, lx0 + lw0/2, cy0,
-                  lx1 + lw1/2, cy1, lx1 - lw1/2, cy1,
-                  rgb(255, 220, 0));
-       }
-
-       if (!prevSeg.tunnel) {
-         int thickness = 50;
-         uint16_t jambaCol = rgb(60, 60, 65);
-         spr.fillRect(roadL0 - thickness, cy0, thickness, p0.y - cy0, jambaCol);
-         spr.fillRect(roadR0, cy0, thickness, p0.y - cy0, jambaCol);
-         spr.fillRect(roadL0 - thickness, cy0, roadR0 - roadL0 + thickness * 2, thickness, jambaCol);
-       }
+      if (tunnelRunStartsAt(n)) drawTunnelRun(n, baseIdx);
+      continue;
     }
 
-    // ── BUILDINGS (only outside tunnel) ─────────────────────────────────────
-    if (!seg.tunnel) {
-      if (seg.buildL > 0) {
-         bool showFront = (prevSeg.buildL == 0 || prevSeg.buildL != seg.buildL) && !prevSeg.tunnel;
-         drawBuilding(p0, p1, seg.buildL, seg.colorL, sIdx, true, showFront);
-      }
-      if (seg.buildR > 0) {
-         bool showFront = (prevSeg.buildR == 0 || prevSeg.buildR != seg.buildR) && !prevSeg.tunnel;
-         drawBuilding(p0, p1, seg.buildR, seg.colorR, sIdx, false, showFront);
-      }
+    // ── BUILDINGS ─────────────────────────────────────────────────────────
+    if (!hiddenByTunnel(n, 0, max(p0.y, p1.y))) {
+      Building bL = buildingAt(segments, sceneSeed, sIdx, true);
+      if (bL.height > 0) drawBuilding(p0, p1, bL, sIdx, true);
+      Building bR = buildingAt(segments, sceneSeed, sIdx, false);
+      if (bR.height > 0) drawBuilding(p0, p1, bR, sIdx, false);
     }
 
     // ── ROAD FOR THIS SEGMENT ────────────────────────────────────────────
     int drawTop = max((int)p1.y, 0);
     int drawBot = min((int)p0.y, (int)rClip[n - 1]);
     int bandH = drawBot - drawTop;
-    if (bandH <= 0) continue;
+    if (bandH <= 0 || hiddenByTunnel(n, drawTop, drawBot)) continue;
 
-    float fogF = expFog((float)n / DRAW_DIST, FOG_DENSITY);
-    bool isLight = ((sIdx / RUMBLE_LEN) % 2) == 0;
-    uint16_t grassCol = lerpCol(isLight ? colGrassL : colGrassD, colFog, fogF);
-    uint16_t wallCol  = isLight ? rgb(35, 32, 30) : rgb(28, 25, 22);
-    uint16_t grass    = seg.tunnel ? wallCol : grassCol;
-    uint16_t road     = lerpCol(isLight ? colRoadL : colRoadD,   colFog, seg.tunnel ? 0 : fogF);
-    uint16_t rumble   = lerpCol(isLight ? colRumbleL : colRumbleD, colFog, seg.tunnel ? 0 : fogF);
-    uint16_t lane     = lerpCol(colLane, colFog, seg.tunnel ? 0 : fogF);
-
-    int subDiv = (bandH > 6) ? min(3, bandH / 3) : 1;
-    for (int s = 0; s < subDiv; s++) {
-      int subTop = drawTop + s * bandH / subDiv;
-      int subBot = drawTop + (s + 1) * bandH / subDiv;
-      int subH   = subBot - subTop;
-      if (subH <= 0) continue;
-
-      float tMid = (float)(2 * s + 1) / (float)(2 * subDiv);
-      int cx  = (int)lerpF(p1.x, p0.x, tMid);
-      int hw  = (int)lerpF(p1.w, p0.w, tMid);
-      int rdL = cx - hw, rdR = cx + hw;
-      int rw  = max(1, hw / 6);
-      int rmL = rdL - rw, rmR = rdR + rw;
-
-      if (seg.tunnel) {
-        bool iLightT = ((sIdx / 3) % 2) == 0;
-        uint16_t wBase = iLightT ? rgb(80, 120, 200) : rgb(50, 80, 150);
-        uint16_t wCol = lerpCol(wBase, TFT_BLACK, fogF * 0.85f);
-        int wallW = max(2, hw / 5);
-        int wlR = max(0, min(rdL, SCR_W)), wlL = max(0, rdL - wallW);
-        if (wlR > wlL) spr.fillRect(wlL, subTop, wlR - wlL, subH, wCol);
-        int wrL = max(0, min(rdR, SCR_W)), wrR = min(SCR_W, rdR + wallW);
-        if (wrR > wrL) spr.fillRect(wrL, subTop, wrR - wrL, subH, wCol);
-      } else {
-        int s1 = max(0, min(rmL, SCR_W));
-        if (s1 > 0) spr.fillRect(0, subTop, s1, subH, grass);
-        int s5 = max(0, min(rmR, SCR_W));
-        if (s5 < SCR_W) spr.fillRect(s5, subTop, SCR_W - s5, subH, grass);
-        int a2 = max(0, rmL), b2 = max(0, min(rdL, SCR_W));
-        if (b2 > a2) spr.fillRect(a2, subTop, b2 - a2, subH, rumble);
-        int a4 = max(0, rdR), b4 = min(SCR_W, rmR);
-        if (b4 > a4) spr.fillRect(a4, subTop, b4 - a4, subH, rumble);
-      }
-      int a3 = max(0, rdL), b3 = min(SCR_W, rdR);
-      if (b3 > a3) spr.fillRect(a3, subTop, b3 - a3, subH, road);
-    }
+    float fogF = expFog((float)n / fogDist, FOG_DENSITY);
+    drawRoadRows(p0, p1, drawTop, drawBot, fogF, position, cameraDepth);
+  }
 
-    // Lane lines
-    if (isLight && p0.w > 15 && bandH > 1) {
-      int midX = (p0.x + p1.x) / 2;
-      int midW = (p0.w + p1.w) / 2;
-      int midY = drawTop + bandH / 2;
-      int lh   = min(bandH, 3);
-      for (int l = 1; l < LANES; l++) {
-        float lt = (float)l / LANES;
-        int lx   = (int)lerpF(midX - midW, midX + midW, lt);
-        int lw   = max(1, midW / 30);
-        spr.fillRect(lx - lw / 2, midY, lw, lh, lane);
-      }
-    }
+  // Visible traffic in one pass over the cars, sorted far to near by
+  // draw slot (insertion sort keeps index order within a segment)
+  VisibleCar* vis = frameAlloc<VisibleCar>(MAX_CARS);
+  int nVis = 0;
+  for (int c = 0; vis && c < MAX_CARS; c++) {
+    int n = findSegIdx(renderCarZ[c]) - baseIdx;
+    if (n < 0) n += TOTAL_SEGS;
+    if (n <= 1 || n >= drawDist) continue;
+    int j = nVis++;
+    for (; j > 0 && vis[j - 1].slot < n; j--) vis[j] = vis[j - 1];
+    vis[j] = { (int16_t)n, (int16_t)c };
   }
+  int nextVis = 0;
 
   // --- THIRD PASS: SPRITES AND TRAFFIC ON TOP OF EVERYTHING ---
-  for (int n = DRAW_DIST - 1; n > 1; n--) {
+  DS_SET_STAGE(DS_SCENERY);
+  for (int n = drawDist - 1; n > 1; n--) {
     int sIdx = (baseIdx + n) % TOTAL_SEGS;
-    Segment& seg = segments[sIdx];
     RenderPt& p1 = rCache[n];
 
     if (p1.scale <= 0 || p1.y >= SCR_H) continue;
-
-    // Normal sprites
-    if (seg.spriteType >= 0) {
-      int sprX = p1.x + (int)(p1.scale * seg.spriteOffset * ROAD_W * SCR_CX);
-      drawSpriteShape(seg.spriteType, sprX, p1.y, p1.scale, rClip[n], timeOfDay);
+    if (hiddenByTunnel(n, 0, p1.y)) continue;
+
+    // Roadside objects, worked out from the segment index
+    Scenery objs[SCENERY_PER_SEG];
+    int count = sceneryAt(segments, sceneSeed, sIdx, objs);
+    for (int i = 0; i < count; i++) {
+      const Scenery& o = objs[i];
+      float sc = p1.scale * o.scale * (1.0f / SCENERY_SCALE_ONE);
+      int sprX = p1.x + (int)(p1.scale * o.offset * (ROAD_W * SCR_CX / 256.0f));
+      drawSpriteShape(o.type, sprX, p1.y, sc, rClip[n], timeOfDay);
     }
 
-    // Traffic
-    for (int c = 0; c < MAX_CARS; c++) {
-      if (findSegIdx(trafficCars[c].z) != sIdx) continue;
-      int carX = p1.x + (int)(p1.scale * trafficCars[c].offset * ROAD_W * SCR_CX);
+    // Traffic (cars of skipped slots are passed over)
+    while (nextVis < nVis && vis[nextVis].slot > n) nextVis++;
+    for (; nextVis < nVis && vis[nextVis].slot == n; nextVis++) {
+      int c = vis[nextVis].car;
+      int carX = p1.x + (int)(p1.scale * fxToF(trafficCars[c].offset) * ROAD_W * SCR_CX);
       drawTrafficCar(carX, p1.y, p1.scale, trafficCars[c].color, rClip[n]);
     }
   }
@@ -0,0 +1,185 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  BITMAP TEXT RENDERING IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "render_text.h"
+#include "memmap.h"
+#include "drawstats.h"
+
+#define FONT_FIRST   0x20
+#define FONT_LAST    0x7E
+#define FONT_GLYPHS  (FONT_LAST - FONT_FIRST + 1)
+
+// ═══════════════════════════════════════════════════════════════
+//  5x7 FONT (classic GLCD layout: 5 columns, bit 0 = top row)
+// ═══════════════════════════════════════════════════════════════
+static const uint8_t PROGMEM font5x7[FONT_GLYPHS][5] = {
+  {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, // ' ' ! "
+  {0x14,0x7F,0x14,0x7F,0x14}, {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, // # $ %
+  {0x36,0x49,0x56,0x20,0x50}, {0x00,0x08,0x07,0x03,0x00}, {0x00,0x1C,0x22,0x41,0x00}, // & ' (
+  {0x00,0x41,0x22,0x1C,0x00}, {0x2A,0x1C,0x7F,0x1C,0x2A}, {0x08,0x08,0x3E,0x08,0x08}, // ) * +
+  {0x00,0x80,0x70,0x30,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x00,0x60,0x60,0x00}, // , - .
+  {0x20,0x10,0x08,0x04,0x02}, {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, // / 0 1
+  {0x72,0x49,0x49,0x49,0x46}, {0x21,0x41,0x49,0x4D,0x33}, {0x18,0x14,0x12,0x7F,0x10}, // 2 3 4
+  {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x31}, {0x41,0x21,0x11,0x09,0x07}, // 5 6 7
+  {0x36,0x49,0x49,0x49,0x36}, {0x46,0x49,0x49,0x29,0x1E}, {0x00,0x00,0x14,0x00,0x00}, // 8 9 :
+  {0x00,0x40,0x34,0x00,0x00}, {0x00,0x08,0x14,0x22,0x41}, {0x14,0x14,0x14,0x14,0x14}, // ; < =
+  {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x59,0x09,0x06}, {0x3E,0x41,0x5D,0x59,0x4E}, // > ? @
+  {0x7C,0x12,0x11,0x12,0x7C}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22}, // A B C
+  {0x7F,0x41,0x41,0x41,0x3E}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, // D E F
+  {0x3E,0x41,0x41,0x51,0x73}, {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, // G H I
+  {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, {0x7F,0x40,0x40,0x40,0x40}, // J K L
+  {0x7F,0x02,0x1C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E}, // M N O
+  {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, // P Q R
+  {0x26,0x49,0x49,0x49,0x32}, {0x03,0x01,0x7F,0x01,0x03}, {0x3F,0x40,0x40,0x40,0x3F}, // S T U
+  {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, {0x63,0x14,0x08,0x14,0x63}, // V W X
+  {0x03,0x04,0x78,0x04,0x03}, {0x61,0x59,0x49,0x4D,0x43}, {0x00,0x7F,0x41,0x41,0x00}, // Y Z [
+  {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, // \ ] ^
+  {0x40,0x40,0x40,0x40,0x40}, {0x00,0x03,0x07,0x08,0x00}, {0x20,0x54,0x54,0x78,0x40}, // _ ` a
+  {0x7F,0x28,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x28}, {0x38,0x44,0x44,0x28,0x7F}, // b c d
+  {0x38,0x54,0x54,0x54,0x18}, {0x00,0x08,0x7E,0x09,0x02}, {0x18,0xA4,0xA4,0x9C,0x78}, // e f g
+  {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x40,0x3D,0x00}, // h i j
+  {0x7F,0x10,0x28,0x44,0x00}, {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x78,0x04,0x78}, // k l m
+  {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, {0xFC,0x18,0x24,0x24,0x18}, // n o p
+  {0x18,0x24,0x24,0x18,0xFC}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x24}, // q r s
+  {0x04,0x04,0x3F,0x44,0x24}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, // t u v
+  {0x3C,0x40,0x30,0x40,0x3C}, {0x44,0x28,0x10,0x28,0x44}, {0x4C,0x90,0x90,0x90,0x7C}, // w x y
+  {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, {0x00,0x00,0x77,0x00,0x00}, // z { |
+  {0x00,0x41,0x36,0x08,0x00}, {0x02,0x01,0x02,0x04,0x02}                              // } ~
+};
+
+// Row masks of each glyph pre-scaled horizontally (bit n = pixel n of the
+// cell); rows are repeated 'size' times vertically at blit time
+static uint32_t glyphAtlas[TEXT_MAX_SIZE][FONT_GLYPHS][TEXT_CELL_H];
+
+// TFT_eSprite keeps 16-bit pixels byte-swapped
+static inline uint16_t fbColor(uint16_t c) {
+  return (uint16_t)((c >> 8) | (c << 8));
+}
+
+static inline void fillRun(uint16_t* row, int x0, int x1, uint16_t c) {
+  for (int x = x0; x < x1; x++) row[x] = c;
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  IMPLEMENTATION
+// ═══════════════════════════════════════════════════════════════
+
+void initText() {
+  for (int s = 1; s <= TEXT_MAX_SIZE; s++) {
+    uint32_t scaled = (1u << s) - 1;
+    for (int g = 0; g < FONT_GLYPHS; g++) {
+      for (int r = 0; r < TEXT_CELL_H; r++) {
+        uint32_t m = 0;
+        for (int c = 0; c < 5; c++) {
+          if ((pgm_read_byte(&font5x7[g][c]) >> r) & 1) m |= scaled << (c * s);
+        }
+        glyphAtlas[s - 1][g][r] = m;
+      }
+    }
+  }
+  memRegister("glyphAtlas", "text", glyphAtlas, sizeof(glyphAtlas), MEM_SRAM, true);
+}
+
+static int blitText(TFT_eSprite& s, int x, int y, const char* str, uint8_t size,
+                    uint16_t fg, uint16_t bg, bool fillBg) {
+  size = constrain(size, 1, TEXT_MAX_SIZE);
+  uint16_t* fb = (uint16_t*)s.getPointer();
+  int fbW = s.width(), fbH = s.height();
+  int cellW = TEXT_CELL_W * size;
+  if (!fb) return x + textWidth(str, size);
+
+  uint16_t fgc = fbColor(fg), bgc = fbColor(bg);
+  DS_COUNT(DP_OTHER, 1, textWidth(str, size) * TEXT_CELL_H * size);   // Cells, not set pixels
+
+  for (; *str; str++, x += cellW) {
+    if (x >= fbW || x + cellW <= 0) continue;
+    int ch = (uint8_t)*str;
+    if (ch < FONT_FIRST || ch > FONT_LAST) ch = '?';
+    const uint32_t* rows = glyphAtlas[size - 1][ch - FONT_FIRST];
+    int cx0 = max(x, 0), cx1 = min(x + cellW, fbW);
+
+    for (int r = 0; r < TEXT_CELL_H; r++) {
+      for (int rep = 0; rep < size; rep++) {
+        int py = y + r * size + rep;
+        if (py < 0 || py >= fbH) continue;
+        uint16_t* row = fb + py * fbW;
+        if (fillBg) fillRun(row, cx0, cx1, bgc);
+
+        // One fill per run of set bits
+        uint32_t m = rows[r];
+        while (m) {
+          int start = __builtin_ctz(m);
+          int len   = __builtin_ctz(~(m >> start));
+          m &= ~(((1u << len) - 1) << start);
+          int a = max(x + start, cx0), b = min(x + start + len, cx1);
+          if (b > a) fillRun(row, a, b, fgc);
+        }
+      }
+    }
+  }
+  return x;
+}
+
+int drawText(TFT_eSprite& s, int x, int y, const char* str, uint8_t size, uint16_t fg) {
+  return blitText(s, x, y, str, size, fg, 0, false);
+}
+
+int drawTextBg(TFT_eSprite& s, int x, int y, const char* str, uint8_t size,
+               uint16_t fg, uint16_t bg) {
+  return blitText(s, x, y, str, size, fg, bg, true);
+}
+
+int textWidth(const char* str, uint8_t size) {
+  return (int)strlen(str) * TEXT_CELL_W * constrain(size, 1, TEXT_MAX_SIZE);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  NUMBER FORMATTING
+// ═══════════════════════════════════════════════════════════════
+
+char* fmtInt(char* dst, int v, int width) {
+  char tmp[12];
+  int n = 0;
+  bool neg = v < 0;
+  unsigned int u = neg ? 0u - (unsigned int)v : (unsigned int)v;
+  do { tmp[n++] = '0' + (u % 10); u /= 10; } while (u);
+  if (neg) tmp[n++] = '-';
+  for (int pad = width - n; pad > 0; pad--) *dst++ = ' ';
+  while (n) *dst++ = tmp[--n];
+  *dst = '\0';
+  return dst;
+}
+
+char* fmtFixed(char* dst, int32_t v, int decimals) {
+  int32_t scale = 1;
+  for (int i = 0; i < decimals; i++) scale *= 10;
+  if (v < 0) { *dst++ = '-'; v = -v; }
+  dst = fmtInt(dst, v / scale);
+  if (decimals > 0) {
+    *dst++ = '.';
+    int32_t frac = v % scale;
+    for (int32_t d = scale / 10; d > 0; d /= 10) *dst++ = '0' + (frac / d) % 10;
+    *dst = '\0';
+  }
+  return dst;
+}
+
+char* fmtLapTime(char* dst, int32_t centis) {
+  if (centis < 0) centis = 0;
+  int32_t mins = centis / 6000;
+  int32_t secs = (centis / 100) % 60;
+  if (mins > 0) {
+    dst = fmtInt(dst, mins);
+    *dst++ = ':';
+    if (secs < 10) *dst++ = '0';
+  }
+  dst = fmtInt(dst, secs);
+  *dst++ = '.';
+  *dst++ = '0' + (centis % 100) / 10;
+  *dst++ = '0' + centis % 10;
+  *dst = '\0';
+  return dst;
+}
@@ -0,0 +1,48 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  BITMAP TEXT RENDERING
+  5x7 font with pre-scaled 1-bit glyph atlases, blitted as row
+  runs straight into the sprite frame buffer (same on device
+  and emulator)
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef RENDER_TEXT_H
+#define RENDER_TEXT_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#define TEXT_MAX_SIZE  3          // Largest pre-scaled atlas (text size 1..3)
+#define TEXT_CELL_W    6          // Glyph cell at size 1 (5 px + 1 spacing)
+#define TEXT_CELL_H    8
+
+// Build the glyph atlases (call once at startup)
+void initText();
+
+// Draw a string with a transparent background, returns the x after it
+int drawText(TFT_eSprite& s, int x, int y, const char* str, uint8_t size, uint16_t fg);
+
+// Draw a string filling each glyph cell with bg, returns the x after it
+int drawTextBg(TFT_eSprite& s, int x, int y, const char* str, uint8_t size,
+               uint16_t fg, uint16_t bg);
+
+// Width in pixels of a string at the given size
+int textWidth(const char* str, uint8_t size);
+
+// ═══════════════════════════════════════════════════════════════
+//  NUMBER FORMATTING (integer only, no print(float))
+//  Each writes a NUL-terminated string and returns a pointer to
+//  the terminator so calls can be chained
+// ═══════════════════════════════════════════════════════════════
+
+// Decimal integer, right-aligned with spaces to at least 'width' chars
+char* fmtInt(char* dst, int v, int width = 0);
+
+// Fixed-point value scaled by 10^decimals: fmtFixed(b, 1234, 2) -> "12.34"
+char* fmtFixed(char* dst, int32_t v, int decimals);
+
+// Lap time from centiseconds: "s.cc" or "m:ss.cc"
+char* fmtLapTime(char* dst, int32_t centis);
+
+#endif // RENDER_TEXT_H
@@ -8,8 +8,23 @@
 #include "rendering.h"
 #include "config.h"
 #include "colors.h"
+#include "arena.h"
+#include "drawstats.h"
+
+// Car vertices (simplified version of the player's)
+static const float trafficVerts[][3] = {
+  // --- LOWER CHASSIS (0-7) ---
+  {-18, 3, -40}, { 18, 3, -40}, { 18, 0,  40}, {-18, 0,  40},
+  {-18, 11, -40}, { 18, 11, -40}, { 20, 10, 40}, {-20, 10, 40},
+
+  // --- CABIN AND WINDOWS (8-15) ---
+  {-15, 11, -13}, { 15, 11, -13}, { 17, 11, 21}, {-17, 11, 21},
+  {-12, 21,  -4}, { 12, 21,  -4}, { 12, 20, 13}, {-12, 20, 13}
+};
+static const int trafficVertCount = sizeof(trafficVerts) / sizeof(trafficVerts[0]);
 
 void drawTrafficCar(int cx, int cy, float scale, uint16_t col, int16_t clipY) {
+  DS_STAGE(DS_TRAFFIC);
   // Minimum scale check
   if (scale < 0.002f) return;
   if (cy >= SCR_H || cy < 0) return;
@@ -20,25 +35,21 @@ void drawTrafficCar(int cx, int cy, float scale, uint16_t col, int16_t clipY) {
   float cosA = cos(angle);
   float sinA = sin(angle);
 
-  // CAR VERTICES (simplified version of player)
-  float verts[16][3] = {
-    // --- LOWER CHASSIS (0-7) ---
-    {-18, 3, -40}, { 18, 3, -40}, { 18, 0,  40}, {-18, 0,  40},
-    {-18, 11, -40}, { 18, 11, -40}, { 20, 10, 40}, {-20, 10, 40},
-
-    // --- CABIN AND WINDOWS (8-15) ---
-    {-15, 11, -13}, { 15, 11, -13}, { 17, 11, 21}, {-17, 11, 21},
-    {-12, 21,  -4}, { 12, 21,  -4}, { 12, 20, 13}, {-12, 20, 13}
-  };
-
-  float sx[16], sy[16];
+  // Projected vertices, scratch in the frame arena
+  size_t mark = frameMark();
+  float* sx = frameAlloc<float>(trafficVertCount);
+  float* sy = frameAlloc<float>(trafficVertCount);
+  if (!sx || !sy) {
+    frameRelease(mark);
+    return;
+  }
 
   // Use the scale directly from the rendering system
   // This scale already accounts for the road perspective
-  for (int i = 0; i < 16; i++) {
+  for (int i = 0; i < trafficVertCount; i++) {
     // 1. Rotation around Y axis (even with angle=0, keep the structure)
-    float rx = verts[i][0] * cosA - verts[i][2] * sinA;
-    float ry = verts[i][1];
+    float rx = trafficVerts[i][0] * cosA - trafficVerts[i][2] * sinA;
+    float ry = trafficVerts[i][1];
 
     // 2. Simple projection: scale and position
     // scale already contains the correct perspective (cameraDepth / camZ)
@@ -55,7 +66,7 @@ void drawTrafficCar(int cx, int cy, float scale, uint16_t col, int16_t clipY) {
       float maxY = max(max(sy[v0], sy[v1]), max(sy[v2], sy[v3]));
       float minY = min(min(sy[v0], sy[v1]), min(sy[v2], sy[v3]));
       if (maxY < 0 || minY > SCR_H) return;
-      drawQuad(sx[v0], sy[v0], sx[v1], sy[v1], sx[v2], sy[v2], sx[v3], sy[v3], faceCol);
+      drawQuad(sx[v0], sy[v0], sx[v1], sy[v1], sx[v2], sy[v2], sx[v3], sy[v3], faceCol, clipY);
     }
   };
 
@@ -86,4 +97,6 @@ void drawTrafficCar(int cx, int cy, float scale, uint16_t col, int16_t clipY) {
   // Front (closest to player camera)
   drawFace(0, 1, 2, 3, darkCol);  // Chassis Base
   drawFace(4, 5, 1, 0, grillCol); // Front Grille
+
+  frameRelease(mark);
 }
@@ -0,0 +1,224 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  TUNNEL RENDERING IMPLEMENTATION
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "render_tunnel.h"
+#include "rendering.h"
+#include "config.h"
+#include "colors.h"
+#include "utils.h"
+#include "track.h"
+#include "drawstats.h"
+
+#define TUNNEL_H      4500.0f     // Ceiling height above the road
+#define TUNNEL_JAMB   50          // Portal frame thickness in pixels
+#define TUNNEL_LIGHTS 4           // A ceiling light every N segments
+
+// Cross-section at boundary n (shared by segments n and n + 1):
+// rCache[n] gives the road edges and floor, ceilY[n] the ceiling
+static int16_t ceilY[DRAW_DIST];
+
+// Opening through which segment n is seen (the intersection of every
+// nearer cross-section of its run), valid where inTunnel[n]
+struct Opening { int16_t l, r, t, b; };
+static Opening opening[DRAW_DIST];
+static bool    runStart[DRAW_DIST];
+static int     runEnd[DRAW_DIST];     // Last segment drawn of the run (by its start)
+static bool    runOpenEnd[DRAW_DIST]; // Run reaches the draw distance
+
+// Nearest tunnel: past exitN, whatever falls inside the entrance
+// (entryOpen) only shows through the exit opening (exitOpen)
+static int     exitN;
+static Opening entryOpen, exitOpen;
+
+// Wall colours fogged by distance, rebuilt when the draw distance changes
+static uint16_t wallCol[2][DRAW_DIST];
+static int      wallColDist = -1;
+static uint16_t lightCol;
+
+static inline bool openingEmpty(const Opening& o) { return o.l >= o.r || o.t >= o.b; }
+
+static Opening crossSection(int n) {
+  const RenderPt& p = rCache[n];
+  return { (int16_t)(p.x - p.w), (int16_t)(p.x + p.w), ceilY[n], p.y };
+}
+
+static Opening intersect(const Opening& a, const Opening& b) {
+  return { max(a.l, b.l), min(a.r, b.r), max(a.t, b.t), min(a.b, b.b) };
+}
+
+static void buildWallColors(int drawDist) {
+  uint16_t light = rgb(80, 120, 200), dark = rgb(50, 80, 150);
+  for (int n = 0; n < drawDist; n++) {
+    float fog = expFog((float)n / drawDist, FOG_DENSITY) * 0.85f;
+    wallCol[0][n] = lerpCol(light, TFT_BLACK, fog);
+    wallCol[1][n] = lerpCol(dark,  TFT_BLACK, fog);
+  }
+  lightCol = rgb(255, 220, 0);
+  wallColDist = drawDist;
+}
+
+void prepareTunnel(int baseIdx, int drawDist, float camY) {
+  if (wallColDist != drawDist) buildWallColors(drawDist);
+
+  exitN = DRAW_DIST;
+  entryOpen = exitOpen = { 0, 0, 0, 0 };
+  Opening open = { 0, 0, 0, 0 };
+  bool nearest = true;
+  int start = -1;
+
+  // The first drawable segment is 2 (rCache[0] is always behind the camera)
+  for (int n = 0; n < drawDist; n++) {
+    runStart[n] = false;
+    int sIdx = (baseIdx + n) % TOTAL_SEGS;
+    const RenderPt& p = rCache[n];
+    if (p.scale > 0)
+      ceilY[n] = SCR_CY - (int)(p.scale * (segments[sIdx].y + TUNNEL_H - camY) * SCR_CY);
+    if (n < 2 || !segments[sIdx].tunnel || rCache[n - 1].scale <= 0) {
+      if (start >= 0) {
+        runEnd[start] = n - 1;
+        runOpenEnd[start] = false;
+        if (nearest) { exitN = n - 1; exitOpen = open; nearest = false; }
+        start = -1;
+      }
+      continue;
+    }
+
+    if (start < 0) {
+      // Near end of a run: the opening starts as the entrance cross-section
+      start = n;
+      runStart[n] = true;
+      Opening screen = { 0, SCR_W, 0, SCR_H };
+      open = intersect(screen, crossSection(n - 1));
+      if (nearest) entryOpen = open;
+    }
+    opening[n] = open;
+    open = intersect(open, crossSection(n));
+  }
+  if (start >= 0) {
+    runEnd[start] = drawDist - 1;
+    runOpenEnd[start] = true;
+    if (nearest) { exitN = drawDist - 1; exitOpen = { 0, 0, 0, 0 }; }
+  }
+}
+
+bool tunnelRunStartsAt(int n) {
+  return runStart[n];
+}
+
+// Only rows are tested (road bands span the full width), so this only
+// culls while the entrance covers the screen width, i.e. from inside
+// the tunnel or right at the portal
+bool hiddenByTunnel(int n, int top, int bottom) {
+  if (n <= exitN) return false;
+  if (entryOpen.l > 0 || entryOpen.r < SCR_W) return false;
+  if (top < entryOpen.t || bottom > entryOpen.b) return false;
+  if (openingEmpty(exitOpen)) return true;
+  return bottom <= exitOpen.t || top >= exitOpen.b;
+}
+
+// One horizontal span clipped to [l, r)
+static inline void span(int y, int a, int b, int l, int r, uint16_t c) {
+  a = max(a, l);
+  b = min(b, r);
+  if (b > a) gfxDrawFastHLine(a, y, b - a, c);
+}
+
+// Segment n of a run: fill the part of its opening that isn't the next
+// cross-section. Floor and ceiling bands are trapezoid rows between the
+// near (n-1) and far (n) edges; in between only the two walls show.
+static void drawTunnelSegment(int n, int sIdx, const Opening& o) {
+  const RenderPt& p0 = rCache[n - 1];
+  const RenderPt& p1 = rCache[n];
+  int l0 = p0.x - p0.w, r0 = p0.x + p0.w, f0 = p0.y, c0 = ceilY[n - 1];
+  int l1 = p1.x - p1.w, r1 = p1.x + p1.w, f1 = p1.y, c1 = ceilY[n];
+
+  bool     light = ((sIdx / RUMBLE_LEN) % 2) == 0;
+  uint16_t wall  = wallCol[(sIdx / 3) % 2][n];
+  uint16_t road  = light ? colRoadL : colRoadD;
+  bool     lamp  = (sIdx % TUNNEL_LIGHTS) == 0;
+
+  // Ceiling band: rows above the far ceiling
+  int cEnd = min((int)o.b, c1);
+  for (int y = o.t; y < cEnd; y++) {
+    float t = (float)(y - c0) / (c1 - c0);
+    int xl = l0 + (int)(t * (l1 - l0));
+    int xr = r0 + (int)(t * (r1 - r0));
+    span(y, o.l, xl, o.l, o.r, wall);
+    if (lamp) {
+      int cx = (xl + xr) / 2;
+      int hw = max(1, (xr - xl) / 8);
+      span(y, xl, cx - hw, o.l, o.r, road);
+      span(y, cx - hw, cx + hw, o.l, o.r, lightCol);
+      span(y, cx + hw, xr, o.l, o.r, road);
+    } else {
+      span(y, xl, xr, o.l, o.r, road);
+    }
+    span(y, xr, o.r, o.l, o.r, wall);
+  }
+
+  // Between far ceiling and far floor: walls either side of the next opening
+  int mTop = max((int)o.t, c1), mBot = min((int)o.b, f1);
+  if (mBot > mTop) {
+    int a = min(l1, (int)o.r), b = max(r1, (int)o.l);
+    if (a > o.l) gfxFillRect(o.l, mTop, a - o.l, mBot - mTop, wall);
+    if (o.r > b) gfxFillRect(b, mTop, o.r - b, mBot - mTop, wall);
+  }
+
+  // Floor band: rows below the far floor
+  int fTop = max((int)o.t, f1);
+  for (int y = fTop; y < o.b; y++) {
+    float t = (float)(y - f0) / (f1 - f0);
+    int xl = l0 + (int)(t * (l1 - l0));
+    int xr = r0 + (int)(t * (r1 - r0));
+    span(y, o.l, xl, o.l, o.r, wall);
+    span(y, xl, xr, o.l, o.r, road);
+    span(y, xr, o.r, o.l, o.r, wall);
+  }
+
+  // Lane marks in the middle of the floor band
+  int bandH = o.b - fTop;
+  if (light && p0.w > 15 && bandH > 1) {
+    int midX = (p0.x + p1.x) / 2;
+    int midW = (p0.w + p1.w) / 2;
+    int midY = fTop + bandH / 2;
+    int lh   = min(bandH, 3);
+    int lw   = max(1, midW / 30);
+    for (int k = 1; k < LANES; k++) {
+      int lx = (int)lerpF(midX - midW, midX + midW, (float)k / LANES) - lw / 2;
+      int a = max(lx, (int)o.l), b = min(lx + lw, (int)o.r);
+      if (b > a) gfxFillRect(a, midY, b - a, lh, colLane);
+    }
+  }
+}
+
+void drawTunnelRun(int n, int baseIdx) {
+  DS_STAGE(DS_TUNNEL);
+  int last = runEnd[n];
+  int m = n;
+  for (; m <= last; m++) {
+    const Opening& o = opening[m];
+    if (openingEmpty(o)) break;  // Everything further is behind the walls
+    drawTunnelSegment(m, (baseIdx + m) % TOTAL_SEGS, o);
+  }
+
+  // Still inside at the draw distance: the rest of the opening is dark
+  if (m > last && runOpenEnd[n]) {
+    Opening o = intersect(opening[last], crossSection(last));
+    if (!openingEmpty(o)) gfxFillRect(o.l, o.t, o.r - o.l, o.b - o.t, TFT_BLACK);
+  }
+
+  // Portal frame around the entrance
+  int sIdx = (baseIdx + n) % TOTAL_SEGS;
+  int prevIdx = (sIdx - 1 + TOTAL_SEGS) % TOTAL_SEGS;
+  if (!segments[prevIdx].tunnel) {
+    const RenderPt& p0 = rCache[n - 1];
+    int l0 = p0.x - p0.w, r0 = p0.x + p0.w, c0 = ceilY[n - 1];
+    uint16_t jamb = rgb(60, 60, 65);
+    gfxFillRect(l0 - TUNNEL_JAMB, c0, TUNNEL_JAMB, p0.y - c0, jamb);
+    gfxFillRect(r0, c0, TUNNEL_JAMB, p0.y - c0, jamb);
+    gfxFillRect(l0 - TUNNEL_JAMB, c0, r0 - l0 + TUNNEL_JAMB * 2, TUNNEL_JAMB, jamb);
+  }
+}
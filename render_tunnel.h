@@ -0,0 +1,32 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  TUNNEL RENDERING
+  A tunnel run is drawn front to back as per-scanline spans
+  (wall | road or ceiling | wall) through a shrinking opening, so
+  each interior pixel is written once and the segment edges
+  projected by drawRoad() are shared between neighbouring faces
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef RENDER_TUNNEL_H
+#define RENDER_TUNNEL_H
+
+#include <Arduino.h>
+
+// Per-frame setup after the projection pass (rCache filled): ceiling
+// heights, the opening in front of each tunnel segment and the exit
+// opening of the nearest tunnel
+void prepareTunnel(int baseIdx, int drawDist, float camY);
+
+// True if segment n is the near end of a tunnel run
+bool tunnelRunStartsAt(int n);
+
+// Draw the whole run starting at segment n (walls, ceiling, lights,
+// road, lane marks, portal); call from the back-to-front loop at n
+void drawTunnelRun(int n, int baseIdx);
+
+// Segments past the nearest tunnel's exit are only visible through its
+// exit opening: true if rows [top, bottom) of segment n can't be seen
+bool hiddenByTunnel(int n, int top, int bottom);
+
+#endif // RENDER_TUNNEL_H
@@ -9,6 +9,7 @@
 #include "config.h"
 #include "colors.h"
 #include "utils.h"
+#include "memmap.h"
 
 // Include submodules
 #include "render_player.h"
@@ -47,6 +48,9 @@ void initBackground() {
     Serial.println("bgSpr created in PSRAM successfully.");
     bgCreated = true;
   }
+  // Read a whole row at a time, so PSRAM is fine for it
+  memRegisterSprite("bgSpr", "rendering", bgSpr, MEM_PSRAM, false);
+  memRegister("rCache", "rendering", rCache, sizeof(rCache) + sizeof(rClip), MEM_SRAM, true);
 
   // 1. Draw sky with vertical gradient (full width)
   // Sunset/city style sky: dark blue at top to orange/purple at bottom
@@ -17,6 +17,7 @@
 #include "render_traffic.h"
 #include "render_road.h"
 #include "render_hud.h"
+#include "gfx.h"
 
 // ═══════════════════════════════════════════════════════════════
 //  GLOBAL RENDERING VARIABLES
@@ -39,7 +40,11 @@ extern int16_t  rClip[DRAW_DIST];
 // Initialize parallax background with procedural skyline
 void initBackground();
 
-// Draw a 3D trapezoid (quad) - helper function
-void drawQuad(int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, uint16_t c);
+// Draw a 3D trapezoid (quad) into the world layer - helper function.
+// Quads with two horizontal or two vertical edges use the trapezoid
+// fills, the rest two triangles; rows at or below clipY are skipped
+// either way
+void drawQuad(int x1, int y1, int x2, int y2, int x3, int y3, int x4, int y4, uint16_t c,
+              int16_t clipY = SCR_H);
 
 #endif // RENDERING_H
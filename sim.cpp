@@ -0,0 +1,321 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  HEADLESS SIMULATION IMPLEMENTATION
+  Integer only inside a tick (Q16.16 values, positions in track
+  units); floats appear only in simInit()
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#include "sim.h"
+#include "track.h"
+#include "utils.h"
+#include <Arduino.h>
+
+#define TRACK_TU   ((int32_t)TOTAL_SEGS << SEG_FX_SHIFT)  // Track length in track units
+#define CAR_HIT_TU ((int32_t)3 << SEG_FX_SHIFT)           // Longitudinal reach of a traffic hit
+#define TRAFFIC_RESORT 16                                   // Ticks between traffic re-sorts
+
+// ═══════════════════════════════════════════════════════════════
+//  HELPERS
+// ═══════════════════════════════════════════════════════════════
+
+static inline int32_t wrapTU(int32_t z) {
+  if (z >= TRACK_TU) return z - TRACK_TU;
+  if (z < 0)         return z + TRACK_TU;
+  return z;
+}
+
+static inline int segOfTU(int32_t z) {
+  return z >> SEG_FX_SHIFT;
+}
+
+// Distance covered in one tick, from a Q16 speed in world units/s
+static inline int32_t tickDistTU(fx_t v) {
+  return v / (SIM_HZ * SEG_LEN);
+}
+
+static inline bool overlapFx(fx_t x1, fx_t w1, fx_t x2, fx_t w2) {
+  fx_t h1 = w1 >> 1, h2 = w2 >> 1;
+  return !((x1 + h1) < (x2 - h2) || (x1 - h1) > (x2 + h2));
+}
+
+// Signed distance from a to b the short way round the loop
+static inline int32_t deltaTU(int32_t a, int32_t b) {
+  int32_t d = b - a;
+  if (d >=  TRACK_TU / 2) return d - TRACK_TU;
+  if (d <  -TRACK_TU / 2) return d + TRACK_TU;
+  return d;
+}
+
+static void crash(SimContext& c) {
+  c.crashed    = true;
+  c.crashTicks = CRASH_TICKS;
+  c.crashes++;
+}
+
+static inline int playerSeg(const SimContext& c) {
+  return segOfTU(wrapTU(c.pos + c.playerZdist));
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  ONE TICK
+// ═══════════════════════════════════════════════════════════════
+
+static void handleInput(SimContext& c, const SimInput& in) {
+  fx_t targetAccel = fxMul(c.maxSpeed, FX(ACCEL_TARGET));
+  if (!in.autopilot) targetAccel = fxMul(targetAccel, fxClamp(in.throttle, 0, FX_ONE));
+
+  // Progressive acceleration (not instantaneous)
+  if (targetAccel > 0 && c.speed < fxMul(c.maxSpeed, FX(ACCEL_NEAR_MAX))) {
+    c.accel += FX(ACCEL_RAMP) / SIM_HZ;
+    if (c.accel > targetAccel) c.accel = targetAccel;
+  } else {
+    c.accel = fxMul(c.accel, c.accelDampingTick);
+  }
+
+  if (in.autopilot) {
+    // === DEMO MODE: counter-steer according to curve + return to center ===
+    fx_t target = -fxMul(c.segments[playerSeg(c)].curveFx, FX(0.12));
+    c.playerX += fxMul(target - c.playerX, FX(STEER_AUTO)) / SIM_HZ;
+    c.playerX  = fxClamp(c.playerX, -FX(0.8), FX(0.8));
+  } else {
+    c.playerX += fxMul(fxClamp(in.steer, -FX_ONE, FX_ONE), FX(STEER_RATE)) / SIM_HZ;
+  }
+}
+
+// Insertion sort of the slots by z (nearly sorted already: only
+// overtakes and cars crossing the start line move anything), and a
+// snapshot of the sorted z values for checkTraffic()
+static void sortTraffic(SimContext& c) {
+  uint8_t* o = c.trafficOrder;
+  for (int i = 1; i < MAX_CARS; i++) {
+    uint8_t slot = o[i];
+    int32_t z = c.traffic[slot].z;
+    int j = i;
+    for (; j > 0 && c.traffic[o[j - 1]].z > z; j--) o[j] = o[j - 1];
+    o[j] = slot;
+  }
+  for (int i = 0; i < MAX_CARS; i++) c.trafficSortZ[i] = c.traffic[o[i]].z;
+  c.trafficSortAge = 0;
+}
+
+static void updatePhysics(SimContext& c) {
+  int pSeg = playerSeg(c);
+  int prevSegIdx = (pSeg - 1 + TOTAL_SEGS) % TOTAL_SEGS;
+  fx_t curve = c.segments[pSeg].curveFx;
+
+  fx_t spPct = fxDiv(c.speed, c.maxSpeed);
+
+  // === GRAVITY: Slope effect (hills/dips) ===
+  fx_t slope = (c.segments[pSeg].yFx - c.segments[prevSegIdx].yFx) / SEG_LEN;  // Terrain slope
+
+  // Going up = slower, going down = faster
+  c.accel -= fxMul(slope, FX(GRAVITY_FACTOR)) / SIM_HZ;
+
+  // === ACCELERATION WITH FRICTION ===
+  c.speed  = fxMul(c.speed, c.frictionTick);
+  c.speed += c.accel / SIM_HZ;
+  c.speed  = fxClamp(c.speed, 0, c.maxSpeed);
+
+  // === DRIFT: Lateral physics in curves ===
+  fx_t curveForce = fxMul(fxMul(curve, c.centrifugal), spPct);
+
+  // Lateral velocity increases with curve force, lateral friction
+  // pulls it back, and it moves the car sideways
+  c.velX += fxMul(curveForce, FX(CURVE_FORCE)) / SIM_HZ;
+  c.velX  = fxMul(c.velX, c.lateralFrictionTick);
+  c.playerX -= c.velX / SIM_HZ;
+
+  // Also apply curve push (centrifugal)
+  fx_t steerDx = fxMul(FX(CENTRIFUGAL_DX), spPct) / SIM_HZ;
+  c.playerX -= fxMul(fxMul(fxMul(steerDx, spPct), curve), c.centrifugal);
+
+  // === VISUAL DRIFT ANGLE ===
+  if (c.speed > FX(0.1)) {
+    c.drift = fxAtan2(c.velX * 10, fxDiv(c.speed, c.maxSpeed)) / 2;
+    c.drift = fxClamp(c.drift, -FX(0.5), FX(0.5));
+  } else {
+    c.drift = fxMul(c.drift, c.driftDecayTick);  // Gradually reduce angle
+  }
+
+  c.prevPos = c.pos;
+  c.pos = wrapTU(c.pos + tickDistTU(c.speed));
+
+  // Detect lap completion
+  if (c.pos < c.prevPos && c.prevPos > TRACK_TU / 10 * 9) {
+    if (c.lapTicks > 5 * SIM_HZ) {
+      c.lastLapTicks = c.lapTicks;
+      if (c.bestLapTicks <= 0 || c.lapTicks < c.bestLapTicks)
+        c.bestLapTicks = c.lapTicks;
+      c.lapsDone++;
+
+      // Advance to next lap, back to 1 after the last one
+      c.lap = (c.lap < c.totalLaps) ? c.lap + 1 : 1;
+    }
+    c.lapTicks = 0;
+  }
+  c.lapTicks++;
+
+  // Update traffic
+  for (int i = 0; i < MAX_CARS; i++) {
+    TrafficCar& car = c.traffic[i];
+    car.z = wrapTU(car.z + tickDistTU(car.speed));
+    // ~2% chance per reference frame, scaled to the tick rate
+    if (rngRange(c.rng, 0, (int)(200 * SIM_HZ / PHYS_REF_HZ)) < 2) {
+      car.offset += rngRange(c.rng, -1, 2) * FX(0.1);
+      car.offset  = fxClamp(car.offset, -FX(0.8), FX(0.8));
+    }
+  }
+  if (++c.trafficSortAge == TRAFFIC_RESORT) sortTraffic(c);
+}
+
+// First trafficSortZ[] index at or past z
+static int firstCarFrom(const SimContext& c, int32_t z) {
+  int lo = 0, hi = MAX_CARS;
+  while (lo < hi) {
+    int mid = (lo + hi) >> 1;
+    if (c.trafficSortZ[mid] < z) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+// Swept test: over the tick the player went from p0 to p0 + dp and each
+// car moved by its own step, so the gap between them changed linearly
+// from g0 to g1. They touched if that range meets [-CAR_HIT_TU, CAR_HIT_TU],
+// whatever the step size. Only cars that can be in reach are visited:
+// a binary search in the last re-sort's snapshot, with the window pulled
+// back by the most a car can have moved since, then a walk along it
+// (across the start line too)
+static void checkTraffic(SimContext& c, int32_t p0, int32_t dp, fx_t playerW) {
+  int32_t maxStep = tickDistTU(c.maxSpeed);  // Traffic never outruns maxSpeed
+  int32_t drift   = c.trafficSortAge * maxStep;
+  int32_t from    = wrapTU(p0 - CAR_HIT_TU - drift);
+  int32_t reach   = dp + 2 * CAR_HIT_TU + maxStep + drift;
+
+  int k = firstCarFrom(c, from);
+  for (int n = 0; n < MAX_CARS; n++, k = (k + 1) % MAX_CARS) {
+    if (wrapTU(c.trafficSortZ[k] - from) > reach) break;
+    const TrafficCar& car = c.traffic[c.trafficOrder[k]];
+
+    int32_t step = tickDistTU(car.speed);
+    int32_t g0 = deltaTU(p0, wrapTU(car.z - step));
+    int32_t g1 = g0 + step - dp;
+    if (min(g0, g1) > CAR_HIT_TU || max(g0, g1) < -CAR_HIT_TU) continue;
+
+    if (c.speed > car.speed && overlapFx(c.playerX, playerW, car.offset, FX(0.15))) {
+      c.speed = fxMul(car.speed, FX(0.7));
+      c.pos   = wrapTU(c.pos - fxMul(c.speed, FX(0.05)) / SEG_LEN);
+      if (c.speed > c.maxSpeed / 2) crash(c);
+    }
+  }
+}
+
+static void checkCollisions(SimContext& c) {
+  const fx_t playerW = FX(0.15);
+  int pSeg = playerSeg(c);
+  const Segment& s = c.segments[pSeg];
+
+  // The player car's path this tick, from prevPos to pos
+  int32_t p0 = wrapTU(c.prevPos + c.playerZdist);
+  int32_t dp = deltaTU(c.prevPos, c.pos);
+
+  // Collisions with traffic
+  checkTraffic(c, p0, dp, playerW);
+
+  // Collisions with tunnel walls
+  if (s.tunnel) {
+    const fx_t wallX = FX(0.95);
+    if (c.playerX < -wallX || c.playerX > wallX) {
+      c.playerX = fxClamp(c.playerX, -wallX, wallX);
+      c.velX    = 0;
+      c.speed   = fxMul(c.speed, FX(0.3));
+      if (c.speed > fxMul(c.maxSpeed, FX(0.35))) crash(c);
+    }
+  }
+
+  // Collisions with roadside objects: the slices of every segment the
+  // car crossed this tick, not just the one it ended on. The span comes
+  // from the path itself, so a pushback above can't stretch it
+  if (c.playerX < -FX_ONE || c.playerX > FX_ONE) {
+    Scenery objs[SCENERY_PER_SEG];
+    int32_t from  = dp < 0 ? wrapTU(p0 + dp) : p0;
+    int     spans = ((from & ((1 << SEG_FX_SHIFT) - 1)) + (dp < 0 ? -dp : dp)) >> SEG_FX_SHIFT;
+    bool hit = false;
+    for (int n = 0, seg = segOfTU(from); n <= spans && !hit; n++, seg = (seg + 1) % TOTAL_SEGS) {
+      int count = sceneryAt(c.segments, c.sceneSeed, seg, objs);
+      for (int i = 0; i < count; i++) {
+        const Scenery& o = objs[i];
+        fx_t w = FX(0.4) * o.scale / SCENERY_SCALE_ONE;
+        if (overlapFx(c.playerX, playerW, (fx_t)o.offset * 256, w)) {
+          c.speed = fxMul(c.speed, FX(0.2));
+          if (c.speed > fxMul(c.maxSpeed, FX(0.25))) crash(c);
+          hit = true;
+          break;
+        }
+      }
+    }
+  }
+
+  // Going completely off the road
+  if (c.playerX <= -FX(2.4) || c.playerX >= FX(2.4)) {
+    c.speed /= 2;
+    if (c.speed > fxMul(c.maxSpeed, FX(0.4))) crash(c);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  PUBLIC API
+// ═══════════════════════════════════════════════════════════════
+
+float simCameraDepth() {
+  float fovRad = FOV_DEG * PI / 180.0;
+  return 1.0 / tanf(fovRad / 2.0);
+}
+
+void simInit(SimContext& c, uint32_t seed) {
+  c.rng = seed ? seed : SIM_SEED;  // xorshift must not start at 0
+
+  // Fixed-point copies of the derived constants, rounded once here
+  c.playerZdist = fxFromF(CAM_HEIGHT * simCameraDepth()) / SEG_LEN;
+  c.maxSpeed    = fxFromF(SEG_LEN * SPEED_MULTIPLIER);
+  c.centrifugal = FX(CENTRIFUGAL);
+
+  // The damping constants were tuned as "per frame" at PHYS_REF_HZ;
+  // rescale them to one SIM_DT tick so handling doesn't depend on FPS
+  float tickRatio       = PHYS_REF_HZ / SIM_HZ;
+  c.frictionTick        = fxFromF(powf(FRICTION, tickRatio));
+  c.lateralFrictionTick = fxFromF(powf(LATERAL_FRICTION, tickRatio));
+  c.accelDampingTick    = fxFromF(powf(ACCEL_DAMPING, tickRatio));
+  c.driftDecayTick      = fxFromF(powf(DRIFT_DECAY, tickRatio));
+
+  buildTrack(c.segments, c.sceneSeed, c.rng);
+  initTraffic(c.traffic, c.maxSpeed, c.rng);
+  for (int i = 0; i < MAX_CARS; i++) c.trafficOrder[i] = i;
+  sortTraffic(c);
+
+  c.pos = c.prevPos = 0;
+  c.playerX = c.speed = c.accel = c.velX = c.drift = 0;
+  c.crashed    = false;
+  c.crashTicks = 0;
+
+  c.lap       = 1;
+  c.totalLaps = RACE_LAPS;
+  c.lapTicks  = c.lastLapTicks = c.bestLapTicks = 0;
+  c.ticks     = 0;
+  c.lapsDone  = 0;
+  c.crashes   = 0;
+}
+
+void simTick(SimContext& c, const SimInput& in) {
+  if (!c.crashed) {
+    handleInput(c, in);
+    updatePhysics(c);
+    checkCollisions(c);
+  } else if (--c.crashTicks <= 0) {
+    c.crashed = false;
+    c.speed   = 0;
+    c.playerX = 0;
+  }
+  c.ticks++;
+}
@@ -0,0 +1,76 @@
+/*
+  ═══════════════════════════════════════════════════════════════
+  HEADLESS SIMULATION
+  Reentrant race state (track, player, traffic, lap timing) and
+  the fixed-tick step that advances it, with no drawing and no
+  globals: the game runs one SimContext, host tools can run many
+  in parallel threads
+  ═══════════════════════════════════════════════════════════════
+*/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include "config.h"
+#include "structs.h"
+#include "fixed.h"
+
+// ═══════════════════════════════════════════════════════════════
+//  INPUT (one sample per tick)
+// ═══════════════════════════════════════════════════════════════
+struct SimInput {
+  bool autopilot;           // true = demo driver, steer/throttle ignored
+  fx_t steer;               // -1 (left) .. 1 (right), Q16.16
+  fx_t throttle;            // 0 .. 1, Q16.16
+};
+
+// ═══════════════════════════════════════════════════════════════
+//  SIMULATION CONTEXT
+//  Track positions are in track units (1 segment = 1 << SEG_FX_SHIFT),
+//  speeds in Q16.16 world units/s
+// ═══════════════════════════════════════════════════════════════
+struct SimContext {
+  Segment    segments[TOTAL_SEGS];
+  uint32_t   sceneSeed;     // Buildings and roadside objects (track.h)
+  TrafficCar traffic[MAX_CARS];
+  uint8_t    trafficOrder[MAX_CARS]; // traffic[] slots by z at the last re-sort
+  int32_t    trafficSortZ[MAX_CARS]; // Their z then, ascending (collision lookups)
+  uint8_t    trafficSortAge;         // Ticks since that re-sort
+  uint32_t   rng;           // xorshift32 state (track, traffic, lane changes)
+
+  // Constants derived from config.h, fixed at simInit()
+  int32_t playerZdist;      // Camera to player car distance, track units
+  fx_t    maxSpeed, centrifugal;
+  fx_t    frictionTick, lateralFrictionTick, accelDampingTick, driftDecayTick;
+
+  // Player
+  int32_t pos, prevPos;     // Camera position (previous tick for lap detection)
+  fx_t    playerX, speed, accel, velX, drift;
+  bool    crashed;
+  int     crashTicks;       // Ticks left until crash recovery
+
+  // Race
+  int      lap, totalLaps;
+  int32_t  lapTicks, lastLapTicks, bestLapTicks;
+  uint32_t ticks;           // Ticks simulated since simInit()
+  uint32_t lapsDone;        // Completed laps (lap counter does not wrap)
+  uint32_t crashes;
+};
+
+// ═══════════════════════════════════════════════════════════════
+//  FUNCTIONS
+// ═══════════════════════════════════════════════════════════════
+
+// Camera depth for FOV_DEG (also used by the renderer)
+float simCameraDepth();
+
+// Build the track and traffic from seed and reset the race
+// (same seed -> same run on every platform)
+void simInit(SimContext& ctx, uint32_t seed);
+
+// Advance exactly one SIM_DT tick: input, physics, collisions and
+// crash recovery. Real-time stepping (the clock, the SIM_MAX_STEPS
+// cap, per-tick input) is stepSimulation()'s job (physics.h)
+void simTick(SimContext& ctx, const SimInput& in);
+
+#endif // SIM_H
@@ -8,6 +8,8 @@
 #define STRUCTS_H
 
 #include <Arduino.h>
+#include "config.h"
+#include "fixed.h"
 
 // ═══════════════════════════════════════════════════════════════
 //  TRACK SEGMENT STRUCTURE
@@ -15,13 +17,30 @@
 struct Segment {
   float curve;              // Segment curvature
   float y;                  // Height (elevation)
-  int8_t spriteType;        // Sprite type (-1 = none)
-  float  spriteOffset;      // Lateral sprite offset
+  fx_t  curveFx, yFx;       // Same in Q16.16, for the fixed-point physics
 
   // -- 3D POLYGONAL PROPERTIES --
   bool   tunnel;            // true = inside tunnel
-  int    buildL, buildR;    // Left/Right building height (0 = no building)
-  uint16_t colorL, colorR;  // Building facade color
+};
+
+// ═══════════════════════════════════════════════════════════════
+//  ROADSIDE
+//  Not stored per segment: sceneryAt() and buildingAt() (track.h)
+//  work them out on demand
+// ═══════════════════════════════════════════════════════════════
+struct Scenery {
+  int8_t   type;            // Sprite type (drawSpriteShape)
+  uint8_t  scale;           // Size, SCENERY_SCALE_ONE = as drawn
+  int16_t  offset;          // Lateral position in road half-widths, Q8.8
+};
+
+#define SCENERY_SCALE_ONE 64
+
+struct Building {
+  int      height;          // World units, 0 = no building
+  uint16_t color;           // Facade color
+  uint8_t  style;           // Window pattern, 0 .. BUILDING_STYLES - 1
+  bool     front;           // First segment of the block: its front face shows
 };
 
 // ═══════════════════════════════════════════════════════════════
@@ -36,9 +55,9 @@ struct RenderPt {
 //  TRAFFIC CAR
 // ═══════════════════════════════════════════════════════════════
 struct TrafficCar {
-  float    offset;          // Lateral offset (-1 to 1)
-  float    z;               // Position on track
-  float    speed;           // Car speed
+  fx_t     offset;          // Lateral offset (-1 to 1), Q16.16
+  int32_t  z;               // Position on track, in track units (see SEG_FX_SHIFT)
+  fx_t     speed;           // Car speed in world units/s, Q16.16
   uint16_t color;           // Car color
 };
 
@@ -12,57 +12,51 @@
 // ═══════════════════════════════════════════════════════════════
 //  GLOBAL TRACK VARIABLES (Definition)
 // ═══════════════════════════════════════════════════════════════
-Segment segments[TOTAL_SEGS];
-int segCount = 0;
-float trackLength;
-
-TrafficCar trafficCars[MAX_CARS];
+float trackLength = (float)TOTAL_SEGS * SEG_LEN;
+
+// Generator state: everything buildTrack() touches, so several
+// tracks can be built at once (headless batch runs)
+struct TrackGen {
+  Segment*  segs;
+  int       count;
+  uint32_t& rng;
+};
 
 // ═══════════════════════════════════════════════════════════════
 //  IMPLEMENTATION
 // ═══════════════════════════════════════════════════════════════
 
-float lastY() {
-  return (segCount == 0) ? 0 : segments[(segCount - 1) % TOTAL_SEGS].y;
+static float lastY(TrackGen& g) {
+  return (g.count == 0) ? 0 : g.segs[(g.count - 1) % TOTAL_SEGS].y;
 }
 
-void addSeg(float curve, float y, bool isTunnel) {
-  if (segCount >= TOTAL_SEGS) return;
-  segments[segCount].curve        = curve;
-  segments[segCount].y            = y;
-  segments[segCount].spriteType   = -1;
-  segments[segCount].spriteOffset = 0;
-  segments[segCount].tunnel       = isTunnel;
-  segments[segCount].buildL       = 0;
-  segments[segCount].buildR       = 0;
-  segments[segCount].colorL       = 0;
-  segments[segCount].colorR       = 0;
-  segCount++;
+static void addSeg(TrackGen& g, float curve, float y, bool isTunnel = false) {
+  if (g.count >= TOTAL_SEGS) return;
+  Segment& s = g.segs[g.count];
+  s.curve        = curve;
+  s.y            = y;
+  s.curveFx      = fxFromF(curve);
+  s.yFx          = fxFromF(y);
+  s.tunnel       = isTunnel;
+  g.count++;
 }
 
-void addRoad(int enter, int hold, int leave, float curve, float hillY) {
-  float sY  = lastY();
+static void addRoad(TrackGen& g, int enter, int hold, int leave, float curve, float hillY) {
+  float sY  = lastY(g);
   float eY  = sY + hillY * SEG_LEN;
   int total = enter + hold + leave;
   for (int n = 0; n < enter; n++)
-    addSeg(easeIn(0, curve, (float)n / enter),
+    addSeg(g, easeIn(0, curve, (float)n / enter),
            easeInOut(sY, eY, (float)n / total));
   for (int n = 0; n < hold; n++)
-    addSeg(curve, easeInOut(sY, eY, (float)(enter + n) / total));
+    addSeg(g, curve, easeInOut(sY, eY, (float)(enter + n) / total));
   for (int n = 0; n < leave; n++)
-    addSeg(easeInOut(curve, 0, (float)n / leave),
+    addSeg(g, easeInOut(curve, 0, (float)n / leave),
            easeInOut(sY, eY, (float)(enter + hold + n) / total));
 }
 
-void addSprite(int idx, int type, float off) {
-  if (idx >= 0 && idx < segCount) {
-    segments[idx].spriteType   = type;
-    segments[idx].spriteOffset = off;
-  }
-}
-
-void buildTrack() {
-  segCount = 0;
+void buildTrack(Segment* segs, uint32_t& sceneSeed, uint32_t& rng) {
+  TrackGen g = { segs, 0, rng };
 
 #if RANDOM_TRACK
   // Random track: combines straights, curves, and hills/dips
@@ -70,16 +64,16 @@ void buildTrack() {
   float pendingReturnMag = 0.0f;
   // Reserve segments at the end for the closing leveling section
   const int CLOSE_SEGS = 20;
-  while (segCount < TOTAL_SEGS - CLOSE_SEGS) {
-    int enter = random(4, 8);
-    int hold  = random(6, 14);
-    int leave = random(4, 8);
+  while (g.count < TOTAL_SEGS - CLOSE_SEGS) {
+    int enter = rngRange(rng, 4, 8);
+    int hold  = rngRange(rng, 6, 14);
+    int leave = rngRange(rng, 4, 8);
     int needed = enter + hold + leave;
 
     // If not enough space for this full section, stop here
-    if (segCount + needed > TOTAL_SEGS - CLOSE_SEGS) break;
+    if (g.count + needed > TOTAL_SEGS - CLOSE_SEGS) break;
 
-    float curve = (float)random(-80, 81) / 10.0f; // -8.0 to 8.0
+    float curve = (float)rngRange(rng, -80, 81) / 10.0f; // -8.0 to 8.0
     if (curve > -2.0f && curve < 2.0f) curve = 0.0f;
 
     float hill = 0.0f;
@@ -88,13 +82,13 @@ void buildTrack() {
       pendingReturnDir = 0;
     } else {
       // Limit hillY so the track doesn't accumulate extreme heights
-      float currentY = lastY();
+      float currentY = lastY(g);
       float maxAllowedHill = 8.0f; // Maximum delta per section
       if (fabsf(currentY) > SEG_LEN * 4) {
         // If already very high/low, force return
         hill = (currentY > 0) ? -maxAllowedHill : maxAllowedHill;
       } else {
-        hill = (float)random(-12, 13); // reduced range: -12 to 12
+        hill = (float)rngRange(rng, -12, 13); // reduced range: -12 to 12
         if (hill > -6.0f && hill < 6.0f) hill = 0.0f;
         if (hill != 0.0f) {
           pendingReturnDir = (hill > 0.0f) ? -1 : 1;
@@ -103,15 +97,15 @@ void buildTrack() {
       }
     }
 
-    addRoad(enter, hold, leave, curve, hill);
+    addRoad(g, enter, hold, leave, curve, hill);
   }
 
   // Closing section: level Y back to 0 so the loop is coherent
   {
-    float currentY = lastY();
+    float currentY = lastY(g);
     if (fabsf(currentY) > SEG_LEN * 0.5f) {
       // Calculate hillY needed to return to 0
-      int closeSegsLeft = TOTAL_SEGS - CLOSE_SEGS - segCount;
+      int closeSegsLeft = TOTAL_SEGS - CLOSE_SEGS - g.count;
       int enter = max(4, closeSegsLeft / 3);
       int hold  = 2;
       int leave = max(4, closeSegsLeft / 3);
@@ -119,91 +113,109 @@ void buildTrack() {
       float hillY = -currentY / (float)SEG_LEN;
       // Limit magnitude
       hillY = max(-14.0f, min(14.0f, hillY));
-      addRoad(enter, hold, leave, 0.0f, hillY);
+      addRoad(g, enter, hold, leave, 0.0f, hillY);
     }
   }
 #else
   // Varied circuit alternating left/right curves and constant hills/dips
   // TOTAL approx: 15 sections x ~13 segs = ~195 segments
-  addRoad(5, 10, 5, 0, 0);           // 1. Start straight
-  addRoad(8, 12, 8, -6.0, 10);       // 2. LEFT + uphill
-  addRoad(5, 8, 5, 0, -15);          // 3. Straight + downhill
-  addRoad(8, 12, 8, 7.0, 0);         // 4. Hard RIGHT
-  addRoad(5, 8, 5, 0, 20);           // 5. Straight + hill
-  addRoad(8, 12, 8, -5.5, -10);      // 6. LEFT + downhill
-  addRoad(5, 8, 5, 0, 0);            // 7. Flat straight
-  addRoad(8, 12, 8, 6.5, 15);        // 8. RIGHT + uphill
-  addRoad(5, 8, 5, 0, -20);          // 9. Straight + downhill
-  addRoad(8, 12, 8, -7.5, 0);        // 10. Extreme LEFT
-  addRoad(5, 8, 5, 0, 10);           // 11. Straight + uphill
-  addRoad(8, 12, 8, 5.0, -15);       // 12. RIGHT + downhill
-  addRoad(5, 8, 5, 0, 0);            // 13. Straight
-  addRoad(8, 12, 8, -6.5, 20);       // 14. LEFT + hill
-  addRoad(5, 10, 5, 0, -10);         // 15. Final straight + downhill
+  addRoad(g, 5, 10, 5, 0, 0);           // 1. Start straight
+  addRoad(g, 8, 12, 8, -6.0, 10);       // 2. LEFT + uphill
+  addRoad(g, 5, 8, 5, 0, -15);          // 3. Straight + downhill
+  addRoad(g, 8, 12, 8, 7.0, 0);         // 4. Hard RIGHT
+  addRoad(g, 5, 8, 5, 0, 20);           // 5. Straight + hill
+  addRoad(g, 8, 12, 8, -5.5, -10);      // 6. LEFT + downhill
+  addRoad(g, 5, 8, 5, 0, 0);            // 7. Flat straight
+  addRoad(g, 8, 12, 8, 6.5, 15);        // 8. RIGHT + uphill
+  addRoad(g, 5, 8, 5, 0, -20);          // 9. Straight + downhill
+  addRoad(g, 8, 12, 8, -7.5, 0);        // 10. Extreme LEFT
+  addRoad(g, 5, 8, 5, 0, 10);           // 11. Straight + uphill
+  addRoad(g, 8, 12, 8, 5.0, -15);       // 12. RIGHT + downhill
+  addRoad(g, 5, 8, 5, 0, 0);            // 13. Straight
+  addRoad(g, 8, 12, 8, -6.5, 20);       // 14. LEFT + hill
+  addRoad(g, 5, 10, 5, 0, -10);         // 15. Final straight + downhill
 #endif
 
   // Fill up to TOTAL_SEGS
-  while (segCount < TOTAL_SEGS) addSeg(0, 0, false);
-  trackLength = (float)TOTAL_SEGS * SEG_LEN;
+  while (g.count < TOTAL_SEGS) addSeg(g, 0, 0, false);
 
   // 1. SINGLE TUNNEL (Only 1 long tunnel, not multiple)
   // Positioned in the second third of the track
   // EXTENSION: 60 segments (longer)
   int tunnelStart = TOTAL_SEGS / 3;
   int tunnelLen = min(60, TOTAL_SEGS - tunnelStart - 1);
-  for (int i = tunnelStart; i < tunnelStart + tunnelLen; i++) {
-    segments[i].tunnel = true;
-    segments[i].buildL = 0; // No buildings inside
-    segments[i].buildR = 0;
-  }
+  for (int i = tunnelStart; i < tunnelStart + tunnelLen; i++) segs[i].tunnel = true;
 
-  // 2. BUILD THE CITY (Varied buildings in New York/Horizon Chase style)
-  int buildCounterL = 0; // Counters for current building duration
-  int buildCounterR = 0;
-  int curBuildL = 0, curBuildR = 0;
-  uint16_t curColL = 0, curColR = 0;
-
-  for (int i = 0; i < TOTAL_SEGS; i++) {
-    if (segments[i].tunnel) continue;
-
-    // --- LEFT SIDE (City-style buildings) ---
-    if (buildCounterL <= 0) {
-      if (random(0, 10) < 6) {
-        curBuildL = random(BUILDING_H_MIN, BUILDING_H_MAX);
-        curColL = rgb(random(40, 140), random(40, 120), random(50, 130));
-        buildCounterL = random(BUILDING_SEG_MIN, BUILDING_SEG_MAX);
-      } else {
-        curBuildL = 0;
-        buildCounterL = random(BUILDING_GAP_MIN, BUILDING_GAP_MAX);
-      }
-    }
-    segments[i].buildL = curBuildL;
-    segments[i].colorL = curColL;
-    buildCounterL--;
-
-    // --- RIGHT SIDE (Independent logic) ---
-    if (buildCounterR <= 0) {
-      if (random(0, 10) < 6) {
-        curBuildR = random(BUILDING_H_MIN, BUILDING_H_MAX);
-        curColR = rgb(random(40, 140), random(40, 120), random(50, 130));
-        buildCounterR = random(BUILDING_SEG_MIN, BUILDING_SEG_MAX);
-      } else {
-        curBuildR = 0;
-        buildCounterR = random(BUILDING_GAP_MIN, BUILDING_GAP_MAX);
-      }
-    }
-    segments[i].buildR = curBuildR;
-    segments[i].colorR = curColR;
-    buildCounterR--;
-  }
+  // 2. The city and the scenery come from this seed (see buildingAt())
+  sceneSeed = rngNext(rng);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  ROADSIDE
+// ═══════════════════════════════════════════════════════════════
+
+enum : uint32_t { HASH_BLOCK, HASH_CLUMP };
+
+// First hash of one roadside decision
+static uint32_t roadsideHash(uint32_t seed, int idx, int side, uint32_t what) {
+  return hash32(seed ^ hash32(((uint32_t)idx << 2 | (side > 0) << 1 | what) * 0x9E3779B9u));
+}
+
+// Each block of BUILDING_BLOCK segments is a gap of at least
+// BUILDING_GAP_MIN and, BUILDING_CHANCE times in 10, a building on its
+// last BUILDING_SEG_MIN .. BUILDING_SEG_MAX segments
+Building buildingAt(const Segment* segs, uint32_t seed, int seg, bool left) {
+  Building b = { 0, 0, 0, false };
+  if (segs[seg].tunnel) return b;
+
+  int block = seg / BUILDING_BLOCK, at = seg % BUILDING_BLOCK;
+  uint32_t h = roadsideHash(seed, block, left ? -1 : 1, HASH_BLOCK);
+  if (hashRange(h, 0, 10) >= BUILDING_CHANCE) return b;
+  int first = BUILDING_BLOCK - hashRange(h = hash32(h), BUILDING_SEG_MIN, BUILDING_SEG_MAX + 1);
+  if (at < first) return b;
+
+  b.height = hashRange(h = hash32(h), BUILDING_H_MIN, BUILDING_H_MAX);
+  uint8_t r  = hashRange(h = hash32(h), 40, 140);
+  uint8_t gr = hashRange(h = hash32(h), 40, 120);
+  uint8_t bl = hashRange(h = hash32(h), 50, 130);
+  b.color = rgb(r, gr, bl);
+  b.style = hashRange(hash32(h), 0, BUILDING_STYLES);
+  // Right behind a tunnel exit the portal stands where the front would
+  b.front = at == first && !segs[(seg + TOTAL_SEGS - 1) % TOTAL_SEGS].tunnel;
+  return b;
+}
 
-  // 3. Trees in gaps between buildings
-  for (int n = 5; n < segCount; n++) {
-    if (segments[n].tunnel || segments[n].buildL > 0 || segments[n].buildR > 0) continue;
-    int r = random(0, 100);
-    if (r < 10) addSprite(n, random(0, 3), -1.5);
-    else if (r < 20) addSprite(n, random(0, 3), 1.5);
+// offset in road half-widths, Q8.8
+static Scenery sprite(int type, int offset, int scale = SCENERY_SCALE_ONE) {
+  return { (int8_t)type, (uint8_t)scale, (int16_t)offset };
+}
+
+// Integer only: checkCollisions() calls this every tick, which has to
+// come out the same on the ESP32 and the PC
+int sceneryAt(const Segment* segs, uint32_t seed, int seg, Scenery* out) {
+  const Segment& s = segs[seg];
+  if (seg < 5 || s.tunnel) return 0;
+  int n = 0;
+
+  // Marker posts on the outside of sharp curves, 1.2 half-widths out
+  if ((s.curveFx >= 4 * FX_ONE || s.curveFx <= -4 * FX_ONE) && seg % RUMBLE_LEN == 0)
+    out[n++] = sprite(4, s.curveFx > 0 ? -307 : 307);
+
+  // Clumps of 1-3 trees and bushes in the gaps between buildings,
+  // each side on its own
+  for (int side = -1; side <= 1; side += 2) {
+    uint32_t h = roadsideHash(seed, seg, side, HASH_CLUMP);
+    if (hashRange(h, 0, 100) >= 12) continue;
+    if (buildingAt(segs, seed, seg, side < 0).height > 0) continue;
+    int clump = hashRange(h = hash32(h), 1, 4);
+    for (int k = 0; k < clump; k++) {
+      int type   = hashRange(h = hash32(h), 0, 4);                  // Pine, tree, bush, rock
+      int tenths = 15 + k * 7 + hashRange(h = hash32(h), 0, 5);     // 1.5 + 0.7 k + 0..0.4
+      int scale  = hashRange(h = hash32(h), 8, 13);                 // 0.8 .. 1.2
+      out[n++] = sprite(type, side * ((tenths * 256 + 5) / 10), (scale * SCENERY_SCALE_ONE + 5) / 10);
+    }
   }
+  return n;
 }
 
 // Traffic colors in Flash (PROGMEM) - saves RAM
@@ -222,11 +234,11 @@ const uint16_t PROGMEM trafficColors[] = {
   0xC5E0   // rgb(200,150,0)  - Gold
 };
 
-void initTraffic(float maxSpeed) {
+void initTraffic(TrafficCar* cars, fx_t maxSpeed, uint32_t& rng) {
   for (int i = 0; i < MAX_CARS; i++) {
-    trafficCars[i].offset = random(-8, 9) / 10.0;
-    trafficCars[i].z      = random(0, TOTAL_SEGS) * SEG_LEN;
-    trafficCars[i].speed  = maxSpeed * (0.2 + random(0, 50) / 100.0);
-    trafficCars[i].color  = pgm_read_word(&trafficColors[i % 12]);
+    cars[i].offset = rngRange(rng, -8, 9) * FX_ONE / 10;
+    cars[i].z      = (int32_t)rngRange(rng, 0, TOTAL_SEGS) << SEG_FX_SHIFT;
+    cars[i].speed  = (fx_t)((int64_t)maxSpeed * (20 + rngRange(rng, 0, 50)) / 100);
+    cars[i].color  = pgm_read_word(&trafficColors[i % 12]);
   }
 }
@@ -13,35 +13,42 @@
 // ═══════════════════════════════════════════════════════════════
 //  GLOBAL TRACK VARIABLES
 // ═══════════════════════════════════════════════════════════════
-extern Segment segments[TOTAL_SEGS];
-extern int segCount;
+extern Segment* segments;         // Track of the running game (owned by physics.cpp)
+extern const uint32_t& sceneSeed; // Its roadside seed
 extern float trackLength;
 
 // ═══════════════════════════════════════════════════════════════
 //  TRACK FUNCTIONS
 // ═══════════════════════════════════════════════════════════════
 
-// Get the height of the last segment
-float lastY();
+// Build the complete track into segs[TOTAL_SEGS], drawing all random
+// choices from rng (same rng state -> same track on every platform),
+// and draw the seed its roadside is hashed from
+void buildTrack(Segment* segs, uint32_t& sceneSeed, uint32_t& rng);
 
-// Add a segment to the track
-void addSeg(float curve, float y, bool isTunnel = false);
-
-// Add a road section with curves and elevation
-void addRoad(int enter, int hold, int leave, float curve, float hillY);
+// ═══════════════════════════════════════════════════════════════
+//  ROADSIDE
+//  Buildings, trees and posts are not stored: each one is a hash of
+//  (seed, segment or block index, side), so they can be asked for in
+//  any order, on a track of any length, and come out the same on the
+//  ESP32 and on the host. Only the track geometry is read (no
+//  buildings in tunnels, posts on sharp curves)
+// ═══════════════════════════════════════════════════════════════
+#define SCENERY_PER_SEG  7        // Most objects on one segment: a post, 3 per side
 
-// Add a sprite to a specific segment
-void addSprite(int idx, int type, float off);
+// Building on one side of segment seg (height 0 = none)
+Building buildingAt(const Segment* segs, uint32_t seed, int seg, bool left);
 
-// Build the complete track
-void buildTrack();
+// Objects standing on segment seg, into out[SCENERY_PER_SEG]; returns
+// how many
+int sceneryAt(const Segment* segs, uint32_t seed, int seg, Scenery* out);
 
 // ═══════════════════════════════════════════════════════════════
 //  TRAFFIC MANAGEMENT
 // ═══════════════════════════════════════════════════════════════
-extern TrafficCar trafficCars[MAX_CARS];
+extern TrafficCar* trafficCars;    // Traffic of the running game
 
-// Initialize traffic cars
-void initTraffic(float maxSpeed);
+// Initialize traffic cars (maxSpeed in Q16.16 world units/s)
+void initTraffic(TrafficCar* cars, fx_t maxSpeed, uint32_t& rng);
 
 #endif // TRACK_H
@@ -55,3 +55,31 @@ bool overlapChk(float x1, float w1, float x2, float w2) {
   float h1 = w1 * 0.5f, h2 = w2 * 0.5f;
   return !((x1 + h1) < (x2 - h2) || (x1 - h1) > (x2 + h2));
 }
+
+uint32_t rngNext(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+int rngRange(uint32_t& state, int lo, int hi) {
+  if (hi <= lo) return lo;
+  return lo + (int)(rngNext(state) % (uint32_t)(hi - lo));
+}
+
+// lowbias32 from Chris Wellons' hash prospector: two multiply and
+// xor-shift rounds
+uint32_t hash32(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7FEB352Du;
+  x ^= x >> 15;
+  x *= 0x846CA68Bu;
+  x ^= x >> 16;
+  return x;
+}
+
+int hashRange(uint32_t h, int lo, int hi) {
+  if (hi <= lo) return lo;
+  return lo + (int)(((uint64_t)h * (uint32_t)(hi - lo)) >> 32);
+}
@@ -40,4 +40,27 @@ float expFog(float d, float density);
 // Check overlap between two objects
 bool overlapChk(float x1, float w1, float x2, float w2);
 
+// ═══════════════════════════════════════════════════════════════
+//  DETERMINISTIC RANDOM (xorshift32, same sequence on every
+//  platform; the state must be non-zero)
+// ═══════════════════════════════════════════════════════════════
+
+// Advance the generator and return the new state
+uint32_t rngNext(uint32_t& state);
+
+// Integer in [lo, hi), like Arduino random(lo, hi)
+int rngRange(uint32_t& state, int lo, int hi);
+
+// ═══════════════════════════════════════════════════════════════
+//  STATELESS HASH (for values that must come out the same whatever
+//  order they are asked for in)
+// ═══════════════════════════════════════════════════════════════
+
+// Integer hash with full avalanche (every input bit flips about half
+// the output bits)
+uint32_t hash32(uint32_t x);
+
+// Integer in [lo, hi) taken from the high bits of h
+int hashRange(uint32_t h, int lo, int hi);
+
 #endif // UTILS_H